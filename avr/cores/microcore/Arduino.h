@@ -19,6 +19,7 @@ https://github.com/MCUdude/MicroCore
 #include <util/delay.h>
 #include <avr/wdt.h>
 #include "WString.h"
+#include "core_settings.h"
 #include "pins_arduino.h"
 #include "binary.h"
 
@@ -28,6 +29,9 @@ extern volatile uint32_t wdt_interrupt_counter;
 // timer0 count variable defined in wiring.c
 extern volatile uint32_t timer0_overflow;
 
+// Current timer0 owner (TIMER0_*) defined in wiring_timer0.c
+extern volatile uint8_t timer0_owner;
+
 // Throw error if LTO is enabled and GCC version is lower than 4.9.2
 #define GCC_VERSION (__GNUC__ * 10000 + __GNUC_MINOR__ * 100 + __GNUC_PATCHLEVEL__)
 #if GCC_VERSION < 40902
@@ -62,6 +66,19 @@ extern "C"{
   #define NOT_A_PIN 0
   #define TIMER0A 1
   #define TIMER0B 2
+  #define PWM_MODE_FAST          3 // WGM01 | WGM00
+  #define PWM_MODE_PHASE_CORRECT 1 // WGM00
+  #define TIMER0_CLOCK   0x01 // Timer0 resources: counter mode, prescaler and TCNT0
+  #define TIMER0_OCA     0x02 // OCR0A, COM0A and OCIE0A
+  #define TIMER0_OCB     0x04 // OCR0B, COM0B and OCIE0B
+  #define TIMER0_OVF     0x08 // TOIE0, and the 256 tick period it needs
+  #define TIMER0_FREE    0x00 // Timer0 owners, see wiring_timer0.c. Free means PWM and micros()
+  #define TIMER0_TONE    (0x10 | TIMER0_CLOCK | TIMER0_OCA | TIMER0_OCB)
+  #define TIMER0_SERVO   (0x20 | TIMER0_CLOCK | TIMER0_OCA | TIMER0_OCB)
+  #define TIMER0_SOFTPWM (0x30 | TIMER0_CLOCK | TIMER0_OCB)
+  #define TIMER0_AUDIO   (0x40 | TIMER0_CLOCK | TIMER0_OCA | TIMER0_OCB | TIMER0_OVF) // TinySynth, TinyDDS, TinySample
+  #define TIMER0_IRSEND  (0x50 | TIMER0_CLOCK | TIMER0_OCA | TIMER0_OCB | TIMER0_OVF)
+  #define TIMER0_IRRECV  (0x60 | TIMER0_OVF)
   #ifdef abs
     #undef abs
   #endif
@@ -90,18 +107,23 @@ extern "C"{
   typedef uint8_t byte;
   typedef bool boolean;
   void init(void);
-  void pinMode(uint8_t pin, uint8_t mode);
-  void digitalWrite(uint8_t pin, uint8_t val);
   void delay(uint16_t ms);
-  uint8_t digitalRead(uint8_t pin);
   int16_t analogRead(uint8_t pin); 
   void analogReference(uint8_t mode);
   void turnOffPWM(uint8_t pin);
   void analogWrite(uint8_t pin, uint8_t val);
+  void analogWriteFrequency(uint32_t hz);
+  void analogWriteMode(uint8_t mode);
+  uint8_t timer0Claim(uint8_t owner);
+  void timer0Release(uint8_t owner);
+  uint8_t timer0AudioBegin(uint8_t level);
+  void timer0AudioEnd(void);
   uint32_t millis(void);
   uint32_t micros(void);
   void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val);
   uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder);
+  void shiftOutBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, const uint8_t *buf, uint8_t length);
+  void shiftInBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t *buf, uint8_t length);
   uint32_t pulseIn(uint8_t pin, uint8_t state, uint32_t timeout);
   void attachInterrupt(uint8_t interruptNum, void (*)(void), uint8_t mode);
   void detachInterrupt(uint8_t interruptNum);
@@ -109,6 +131,52 @@ extern "C"{
   void loop(void);
   void yield(void) __attribute__ ((weak, alias("__empty")));
   static void __empty() { /* Empty*/ }
+
+  // pinMode(), digitalWrite() and digitalRead() are real functions in wiring_digital.c, so they
+  // can be declared extern or have their address taken. The gnu_inline versions below are only
+  // used for inlining: when the pin number is a compile-time constant they boil down to single
+  // sbi/cbi/sbic instructions. Everything else calls the out-of-line function, through an alias
+  // with the same symbol name, which is also where SAFEMODE checks the pin number
+  void pinMode_call(uint8_t pin, uint8_t mode) __asm__("pinMode");
+  void digitalWrite_call(uint8_t pin, uint8_t val) __asm__("digitalWrite");
+  uint8_t digitalRead_call(uint8_t pin) __asm__("digitalRead");
+
+  extern inline __attribute__((gnu_inline, always_inline)) void pinMode(uint8_t pin, uint8_t mode)
+  {
+    if(__builtin_constant_p(pin) && __builtin_constant_p(mode) && pin <= 5)
+    {
+      if(mode == OUTPUT) // Pin as output
+        DDRB |= _BV(pin);
+      else // Pin as input or input pullup
+      {
+        DDRB &= ~_BV(pin); // Set pin as input
+        if(mode == INPUT_PULLUP)
+          PORTB |= _BV(pin); // Enable pullup resistors
+      }
+    }
+    else
+      pinMode_call(pin, mode);
+  }
+
+  extern inline __attribute__((gnu_inline, always_inline)) void digitalWrite(uint8_t pin, uint8_t val)
+  {
+    if(__builtin_constant_p(pin) && pin <= 5)
+    {
+      if(val)
+        PORTB |= _BV(pin);  // Set pin high
+      else
+        PORTB &= ~_BV(pin); // Set pin low
+    }
+    else
+      digitalWrite_call(pin, val);
+  }
+
+  extern inline __attribute__((gnu_inline, always_inline)) uint8_t digitalRead(uint8_t pin)
+  {
+    if(__builtin_constant_p(pin) && pin <= 5)
+      return !!(PINB & _BV(pin));
+    return digitalRead_call(pin);
+  }
  
 #ifdef __cplusplus
 } // extern "C"
@@ -117,10 +185,19 @@ extern "C"{
 #ifdef __cplusplus
 
   #include "HalfDuplexSerial.h"
+  #include "FastPin.h"
 
   // Tone functions
   void tone(uint8_t pin, uint16_t frequency, uint32_t duration = 0);
   void toneRaw(uint8_t pin, uint8_t midPoint, uint32_t lengthTicks, uint8_t prescaleBitMask);
+  #ifdef TONE_HW_TOGGLE
+    #define MIDI_NOTE_LOWEST  48 // C3, lowest note toneNote() can play
+    #define MIDI_NOTE_HIGHEST 84 // C6
+    #define TONE_TICK_MS      19 // Length of a toneNote() tick (the millis() watchdog tick)
+    void toneHardware(uint8_t pin, uint8_t top, uint16_t ticks, uint8_t prescaleBitMask);
+    void toneNote(uint8_t pin, uint8_t note, uint16_t ticks = 0);
+    void toneRest(uint8_t pin, uint16_t ticks);
+  #endif
   void noTone(uint8_t pin = 255);
   void stopTone(void);
  
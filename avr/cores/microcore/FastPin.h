@@ -0,0 +1,130 @@
+/*** MicroCore - FastPin.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+This file contains a zero-cost template layer
+over PORTB, DDRB and PINB. FastPin<N> drives a
+single pin, Bus<mask> drives several pins with
+one port write. Everything is resolved at
+compile time, so FastPin<PB3>::toggle() is a
+single sbi instruction.
+
+PB0 and PB1 are shared with the software UART
+and the Timer0 PWM outputs. Using them requires
+PIN_RELEASED as the second template parameter,
+which states that Serial and analogWrite() are
+not using the pin:
+  FastPin<PB0, PIN_RELEASED>::output();
+*/
+
+#ifndef FastPin_h
+#define FastPin_h
+
+#include <avr/io.h>
+#include "core_settings.h"
+
+enum FastPinClaim : uint8_t
+{
+  PIN_DEFAULT  = 0, // Pin must not be shared with Serial or PWM
+  PIN_RELEASED = 1, // Sketch guarantees Serial and analogWrite() leave the pin alone
+};
+
+// Mask of the pins that are used by other core functions
+#define FASTPIN_SHARED_MASK (_BV(UART_TX_PIN) | _BV(UART_RX_PIN) | _BV(PB0) | _BV(PB1))
+
+
+template <uint8_t mask, FastPinClaim claim = PIN_DEFAULT>
+struct Bus
+{
+  static_assert(mask != 0 && (mask & ~0x3F) == 0, "Bus mask must only contain PB0..PB5");
+  static_assert(claim == PIN_RELEASED || (mask & FASTPIN_SHARED_MASK) == 0,
+                "Bus mask contains a UART or PWM pin; use PIN_RELEASED if Serial and analogWrite() don't use it");
+
+  // Turn Timer0 PWM off on any OC0A/OC0B pin in the mask
+  __attribute__((always_inline)) static inline void releasePWM()
+  {
+    if(mask & _BV(PB0))
+      TCCR0A &= ~_BV(COM0A1);
+    if(mask & _BV(PB1))
+      TCCR0A &= ~_BV(COM0B1);
+  }
+
+  __attribute__((always_inline)) static inline void output() { DDRB |= mask; }
+  __attribute__((always_inline)) static inline void input()  { DDRB &= ~mask; }
+
+  // Write all pins in the mask with a single out instruction.
+  // Bits of val outside the mask are ignored. Not interrupt safe, see writeAtomic()
+  __attribute__((always_inline)) static inline void write(uint8_t val)
+  {
+    PORTB = (PORTB & ~mask) | (val & mask);
+  }
+
+  // Same as write(), but interrupts can't modify PORTB between the read and the write
+  __attribute__((always_inline)) static inline void writeAtomic(uint8_t val)
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    write(val);
+    SREG = oldSREG;
+  }
+
+  // Set or clear the pins in bits (must be a subset of mask) atomically
+  __attribute__((always_inline)) static inline void set(uint8_t bits = mask)
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    PORTB |= bits & mask;
+    SREG = oldSREG;
+  }
+
+  __attribute__((always_inline)) static inline void clear(uint8_t bits = mask)
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    PORTB &= ~(bits & mask);
+    SREG = oldSREG;
+  }
+
+  // Writing a one to PINB toggles the output, which is atomic by itself (ldi + out)
+  __attribute__((always_inline)) static inline void toggle(uint8_t bits = mask)
+  {
+    PINB = bits & mask;
+  }
+
+  __attribute__((always_inline)) static inline uint8_t read() { return PINB & mask; }
+};
+
+
+template <uint8_t pin, FastPinClaim claim = PIN_DEFAULT>
+struct FastPin
+{
+  static_assert(pin < NUM_DIGITAL_PINS, "FastPin number out of range");
+  static_assert(claim == PIN_RELEASED || (_BV(pin) & FASTPIN_SHARED_MASK) == 0,
+                "FastPin is a UART or PWM pin; use PIN_RELEASED if Serial and analogWrite() don't use it");
+
+  static constexpr uint8_t mask = _BV(pin);
+
+  __attribute__((always_inline)) static inline void releasePWM() { Bus<_BV(pin), claim>::releasePWM(); }
+
+  __attribute__((always_inline)) static inline void output() { DDRB |= _BV(pin); }
+  __attribute__((always_inline)) static inline void input()  { DDRB &= ~_BV(pin); }
+  __attribute__((always_inline)) static inline void pullup() { DDRB &= ~_BV(pin); PORTB |= _BV(pin); }
+
+  __attribute__((always_inline)) static inline void high()   { PORTB |= _BV(pin); }
+  __attribute__((always_inline)) static inline void low()    { PORTB &= ~_BV(pin); }
+  // sbi only writes the one bit, so on PINB it toggles just this pin
+  __attribute__((always_inline)) static inline void toggle() { PINB |= _BV(pin); }
+
+  __attribute__((always_inline)) static inline void write(uint8_t val)
+  {
+    if(val)
+      high();
+    else
+      low();
+  }
+
+  __attribute__((always_inline)) static inline uint8_t read() { return !!(PINB & _BV(pin)); }
+};
+
+#endif
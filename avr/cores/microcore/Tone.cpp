@@ -28,6 +28,62 @@ static __uint24 CurrentToneDuration = 0;
 static uint8_t  CurrentTonePin      = 0;
 static uint8_t  CurrentToneMidpoint = 0;
 
+// Timer0 as it was before the tone started (TCCR0A, TCCR0B, OCR0A, OCR0B and
+// TIMSK0), put back when the tone ends. tone_active is set while they're saved
+extern "C" uint8_t tone_saved[5];
+extern "C" volatile uint8_t tone_active;
+uint8_t tone_saved[5];
+volatile uint8_t tone_active;
+
+// Set by TinyMelody while a melody plays. A hardware tone that runs out then
+// leaves Timer0 as it is, so the setup from before the melody doesn't come back
+// for a moment between two notes
+extern "C" volatile uint8_t tone_hold;
+volatile uint8_t tone_hold;
+
+#ifdef TONE_HW_TOGGLE
+  // Counted down by the millis() watchdog tick (see tone_wdt.S)
+  extern "C" volatile uint16_t tone_wdt_ticks;
+#endif
+
+
+// Interrupts have to be off. A tone that starts while another one plays keeps the
+// settings from before the first one. The owner is set again, since the first
+// tone can run out between timer0Claim() and cli()
+static void saveTimer0()
+{
+  timer0_owner = TIMER0_TONE;
+  if(tone_active)
+    return;
+  tone_saved[0] = TCCR0A;
+  tone_saved[1] = TCCR0B;
+  tone_saved[2] = OCR0A;
+  tone_saved[3] = OCR0B;
+  tone_saved[4] = TIMSK0;
+  tone_active = 1;
+}
+
+
+// Interrupts have to be off. Stops the tone and gives Timer0 back to PWM and
+// micros(). The same is done in tone_wdt.S when a hardware tone ends
+static void restoreTimer0()
+{
+  #ifdef TONE_HW_TOGGLE
+    tone_wdt_ticks = 0;
+  #endif
+  timer0Release(TIMER0_TONE); // Also claimed by a melody that starts with a rest
+  if(!tone_active)
+    return;
+  TCCR0B = 0;
+  OCR0A  = tone_saved[2];
+  OCR0B  = tone_saved[3];
+  TCCR0A = tone_saved[0];
+  TIFR0  = _BV(OCF0A) | _BV(OCF0B);
+  TIMSK0 = tone_saved[4];
+  TCCR0B = tone_saved[1];
+  tone_active = 0;
+}
+
 #ifndef TONE_MIN_FREQ
   #define TONE_MIN_FREQ 130 // 130.81 = C3
 #endif
@@ -98,11 +154,62 @@ void tone(const uint8_t pin, const uint16_t frequency, const uint32_t length)
   }
   else
     return;
-  
-  toneRaw(pin, (((F_CPU / prescaleDivider) / frequency) / 2), length ? length * ticksPerMs : ~(0UL), prescaleBitMask);
+
+  const uint8_t midPoint = ((F_CPU / prescaleDivider) / frequency) / 2;
+
+  #ifdef TONE_HW_TOGGLE
+    if(pin <= PB1)
+    {
+      // length / 19 is close enough to length * 27 / 512, and a lot smaller
+      uint16_t ticks = 0;
+      if(length)
+      {
+        const uint32_t t = (length * 27) >> 9;
+        ticks = (t > 0xFFFF) ? 0xFFFF : (t ? t : 1);
+      }
+      return toneHardware(pin, midPoint ? midPoint - 1 : 0, ticks, prescaleBitMask);
+    }
+  #endif
+
+  toneRaw(pin, midPoint, length ? length * ticksPerMs : ~(0UL), prescaleBitMask);
 }
 
 
+#ifdef TONE_HW_TOGGLE
+// Timer0 in CTC mode toggles OC0A (PB0) or OC0B (PB1) on every compare match,
+// so the waveform doesn't need the CPU at all. OCR0B is 0, which is always
+// reached because OCR0A sets TOP for both channels.
+// The pin toggles every top + 1 timer ticks. The duration is counted in watchdog
+// ticks of about 19 ms, the same tick millis() uses, and 0 plays until noTone().
+// The first tick can come anywhere within the first 19 ms, so a tone can be up
+// to one tick shorter than asked for. Pins other than PB0 and PB1 are ignored,
+// and so is the call while another library owns Timer0.
+void toneHardware(uint8_t pin, uint8_t top, uint16_t ticks, uint8_t prescaleBitMask)
+{
+  if(pin > PB1) // Only OC0A and OC0B can be toggled by Timer0
+    return;
+  if(!timer0Claim(TIMER0_TONE))
+    return;
+  CurrentTonePin = _BV(pin);
+  PORTB &= ~_BV(pin); // The pin is low when the tone ends and the toggling is disconnected
+  DDRB |= _BV(pin);
+
+  uint8_t oldSREG = SREG;
+  cli();
+  saveTimer0();
+  TIMSK0 &= ~_BV(OCIE0A);
+  TCCR0B = 0;
+  TCNT0  = 0;
+  OCR0A  = top;
+  OCR0B  = 0;
+  TCCR0A = _BV(WGM01) | ((pin == PB0) ? _BV(COM0A0) : _BV(COM0B0));
+  tone_wdt_ticks = ticks;
+  TCCR0B = prescaleBitMask;
+  SREG = oldSREG;
+}
+#endif
+
+
 void toneRaw(uint8_t pin, uint8_t midPoint, uint32_t lengthTicks, uint8_t prescaleBitMask) 
 {
 
@@ -119,6 +226,10 @@ void toneRaw(uint8_t pin, uint8_t midPoint, uint32_t lengthTicks, uint8_t presca
   //
   // So instead we calculate how many ticks the tone should go for and subtract
   // ticks as we hit the mid-point.
+
+  // Servo, TinySoftPWM and the audio libraries keep Timer0 until they're done
+  if(!timer0Claim(TIMER0_TONE))
+    return;
     
   CurrentToneDuration = lengthTicks;
 
@@ -127,6 +238,10 @@ void toneRaw(uint8_t pin, uint8_t midPoint, uint32_t lengthTicks, uint8_t presca
     
   // Shut down interrupts while we fiddle about with the timer.
   cli();
+  saveTimer0();
+  #ifdef TONE_HW_TOGGLE
+    tone_wdt_ticks = 0; // A hardware tone this one replaces mustn't end it
+  #endif
   
   TCCR0B &= ~0b00000111; // Turn off the timer before changing anytning
   TCNT0   = 0;           // Timer counter back to zero
@@ -151,69 +266,133 @@ void toneRaw(uint8_t pin, uint8_t midPoint, uint32_t lengthTicks, uint8_t presca
 }
 
 
-void noTone(uint8_t pin) 
+#ifdef TONE_HW_TOGGLE
+// Timer0 setup for every note from MIDI_NOTE_LOWEST to MIDI_NOTE_HIGHEST, worked out
+// by the compiler for the current F_CPU. Each note gets the smallest prescaler
+// that fits its half period in OCR0A, which gives the best pitch accuracy
+struct ToneNote
 {
-  // Disable the interrupt
-  // Note we can leave the rest of the timer setup as is, turnOnPWM() will
-  // fix it for itself next time you analogWrite() if you need to.
-  TIMSK0 &= ~_BV(OCIE0A);
-  
-  // Pin goes back to input state  
-  DDRB &= ~pin;
+  uint8_t top;
+  uint8_t prescaleBitMask;
+};
+
+// A4 (69) is 440 Hz, and every semitone is a factor 2^(1/12)
+static constexpr double noteFrequency(int8_t note)
+{
+  return note > 69 ? noteFrequency(note - 1) * 1.0594630943592953
+       : note < 69 ? noteFrequency(note + 1) / 1.0594630943592953
+       : 440.0;
 }
 
+static constexpr uint32_t noteHalfPeriod(int8_t note, uint16_t prescaler)
+{
+  return F_CPU / prescaler / noteFrequency(note) / 2 + 0.5;
+}
+
+static constexpr uint8_t notePrescaleBitMask(int8_t note)
+{
+  return noteHalfPeriod(note, 1)   <= 256 ? 1
+       : noteHalfPeriod(note, 8)   <= 256 ? 2
+       : noteHalfPeriod(note, 64)  <= 256 ? 3
+       : noteHalfPeriod(note, 256) <= 256 ? 4
+       : 5;
+}
+
+static constexpr uint8_t noteTop(int8_t note)
+{
+  return noteHalfPeriod(note, notePrescaleBitMask(note) == 1 ? 1
+                            : notePrescaleBitMask(note) == 2 ? 8
+                            : notePrescaleBitMask(note) == 3 ? 64
+                            : notePrescaleBitMask(note) == 4 ? 256 : 1024) - 1;
+}
+
+#define TONE_NOTE(n) { noteTop(n), notePrescaleBitMask(n) }
+#define TONE_OCTAVE(n) TONE_NOTE(n),     TONE_NOTE(n + 1), TONE_NOTE(n + 2), TONE_NOTE(n + 3), \
+                       TONE_NOTE(n + 4), TONE_NOTE(n + 5), TONE_NOTE(n + 6), TONE_NOTE(n + 7), \
+                       TONE_NOTE(n + 8), TONE_NOTE(n + 9), TONE_NOTE(n + 10), TONE_NOTE(n + 11)
+
+static const ToneNote toneNotes[] PROGMEM =
+{
+  TONE_OCTAVE(MIDI_NOTE_LOWEST), TONE_OCTAVE(MIDI_NOTE_LOWEST + 12), TONE_OCTAVE(MIDI_NOTE_LOWEST + 24),
+  TONE_NOTE(MIDI_NOTE_HIGHEST)
+};
+
+
+// Plays a MIDI note (60 is middle C) on PB0 or PB1 for a number of watchdog ticks
+// (about 19 ms each), or until noTone() if ticks is 0. Notes outside the table and
+// other pins are ignored.
+// Only a table lookup, so it's a lot smaller and faster than tone()
+void toneNote(uint8_t pin, uint8_t note, uint16_t ticks)
+{
+  note -= MIDI_NOTE_LOWEST;
+  if(note > MIDI_NOTE_HIGHEST - MIDI_NOTE_LOWEST)
+    return;
+  const ToneNote *entry = &toneNotes[note];
+  toneHardware(pin, pgm_read_byte(&entry->top), ticks, pgm_read_byte(&entry->prescaleBitMask));
+}
+
+
+
+// Holds on to Timer0 like toneNote() for a number of watchdog ticks, but without
+// a sound: the pin is disconnected from Timer0, PWM included, and stays low.
+// Used for the rests in a melody. Pins other than PB0 and PB1 are ignored
+void toneRest(uint8_t pin, uint16_t ticks)
+{
+  if(pin > PB1 || !timer0Claim(TIMER0_TONE))
+    return;
+  PORTB &= ~_BV(pin);
+
+  uint8_t oldSREG = SREG;
+  cli();
+  saveTimer0();
+  TCCR0A &= (pin == PB0) ? ~(_BV(COM0A1) | _BV(COM0A0)) : ~(_BV(COM0B1) | _BV(COM0B0));
+  tone_wdt_ticks = ticks;
+  SREG = oldSREG;
+}
+#endif
 
-// This function will reset Timer0 back to its default setting
+
+// Stops the tone and releases its pin. pinMask is a bit mask, not a pin number
+static void endTone(uint8_t pinMask)
+{
+  uint8_t oldSREG = SREG;
+  cli();
+  restoreTimer0();
+  SREG = oldSREG;
+
+  // Pin goes back to input state
+  DDRB &= ~pinMask;
+}
+
+
+void noTone(uint8_t pin)
+{
+  // The default pin (255) is whatever pin the tone is playing on
+  endTone((pin == 255) ? CurrentTonePin : _BV(pin));
+}
+
+
+// Stops the tone and puts Timer0 back the way it was before the tone started,
+// but leaves the pin as it is. Without a tone to stop, and with micros() enabled,
+// a free Timer0 gets the micros() prescaler and overflow interrupt back, like
+// stopTone() always did
 void stopTone()
 {
-  // Resets timer0 to it's default value defined in core_settings.h
-  #ifdef SETUP_PWM  
-    // Set Timer0 prescaler
-    #if defined(PWM_PRESCALER_DEFAULT)
+  uint8_t oldSREG = SREG;
+  cli();
+  #ifdef ENABLE_MICROS
+    if(!tone_active && timer0_owner == TIMER0_FREE)
+    {
       #if F_CPU >= 4800000L
-        TCCR0B |= _BV(CS00) | _BV(CS01); // PWM frequency = (F_CPU/256) / 64
-      #else  
-        TCCR0B |= _BV(CS01);             // PWM frequency = (F_CPU/256) / 8
+        TCCR0B = _BV(CS00) | _BV(CS01); // F_CPU/64
+      #else
+        TCCR0B = _BV(CS01);             // F_CPU/8
       #endif
-    #elif defined(PWM_PRESCALER_NONE)    // PWM frequency = (F_CPU/256) / 1
-      TCCR0B |= _BV(CS00);
-    #elif  defined(PWM_PRESCALER_8)      // PWM frequency = (F_CPU/256) / 8
-      TCCR0B |= _BV(CS01);
-    #elif  defined(PWM_PRESCALER_64)     // PWM frequency = (F_CPU/256) / 64
-      TCCR0B |= _BV(CS00) | _BV(CS01);
-    #elif  defined(PWM_PRESCALER_256)    // PWM frequency = (F_CPU/256) / 256
-      TCCR0B |= _BV(CS02);
-    #elif  defined(PWM_PRESCALER_1024)   // PWM frequency = (F_CPU/256) / 1024
-      TCCR0B |= _BV(CS00) | _BV(CS02);
-    #endif
-    
-    // Set waveform generation mode
-    #if defined(PWM_FAST)
-      TCCR0A |= _BV(WGM00) | _BV(WGM01);
-    #elif defined(PWM_PHASE_CORRECT)
-      TCCR0A |= _BV(WGM00);
-    #endif
-  #endif  
-  
-  // Override previous PWM setup if micros() is enabled
-  #ifdef ENABLE_MICROS     
-    // Clear all Timer0 settings
-    TCCR0B = 0;
-    // Set a suited prescaler based on F_CPU
-    #if F_CPU >= 4800000L
-      TCCR0B |= _BV(CS00) | _BV(CS01); // F_CPU/64 
-    #else  
-      TCCR0B |= _BV(CS01);             // F_CPU/8
-    #endif      
-    // Enable overflow interrupt on Timer0
-    TIMSK0 |= _BV(TOIE0);
-    // Set timer0 couter to zero
-    TCNT0 = 0;
-    // Clear Timer0 overflow counter
-    timer0_overflow = 0;
-    // Turn on global interrupts
-    sei();
+      TIMSK0 |= _BV(TOIE0);
+    }
   #endif
+  restoreTimer0();
+  SREG = oldSREG;
 }
 
 
@@ -228,7 +407,7 @@ ISR(TIM0_COMPA_vect)
   
   // If we have played this tone for the requested duration, stop playing it.
   if (toneDuration < toneMidpoint)
-    noTone(tonePin); 
+    endTone(tonePin);
   CurrentToneDuration = toneDuration - toneMidpoint;
   
   TCNT0 = 0; // Restart timer
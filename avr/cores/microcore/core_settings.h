@@ -56,6 +56,13 @@ need in order to free up space.
 #define SAFEMODE
 
 
+// Replaces the shiftIn() bit loop with an unrolled assembly sequence. Every bit then takes a fixed 7 clock
+// cycles instead of around 11 (8 at 8 to 12 MHz and 9 at 16 and 20 MHz, where the data pin is read later
+// to give an HX711 the 100 ns it needs after SCK goes high), at the cost of up to 220 bytes of extra flash
+// (half of that if the bit order is a constant and LTO is enabled).
+//#define SHIFT_UNROLLED
+
+
 // This is the ADC settings
 // Here the ADC prescaler can be changed if needed.
 // Note that the sample rate should exceed 200 kHz
@@ -70,7 +77,8 @@ need in order to free up space.
 
 
 // Here's the PWM settings for Timer0
-// These settings will also be disabled if SETUP_PWM is commented out
+// These are the defaults analogWrite() starts with. analogWriteFrequency() and analogWriteMode()
+// change them at runtime.
 // Note that ENABLE_MICROS will override this setting
 #define PWM_PRESCALER_AUTO    // Selects the "best suited" prescaler based on F_CPU
 //#define PWM_PRESCALER_NONE  // PWM frequency = (F_CPU/256) / 1
@@ -85,6 +93,13 @@ need in order to free up space.
 //#define PWM_PHASE_CORRECT
 
 
+// tone() on PB0 and PB1 lets Timer0 toggle the pin in hardware (CTC mode with OC0A/OC0B), so the tone
+// itself takes no CPU time at all. The duration is then counted on the millis() watchdog tick, and is
+// rounded to about 19 ms. Comment this out to use the interrupt driven tone on every pin, which has an
+// exact duration but interrupts the CPU twice per period.
+#define TONE_HW_TOGGLE
+
+
 // Enabling micros() will cause the processor to interrupt more often (every 2048th clock cycle if
 // F_CPU < 4.8 MHz, every 16384th clock cycle if F_CPU >= 4.8 MHz. This will add some overhead when F_CPU is
 // less than 4.8 MHz. It's disabled by default because it occupies precious flash space and loads the CPU with
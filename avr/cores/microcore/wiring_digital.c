@@ -7,6 +7,9 @@ https://github.com/MCUdude/MicroCore
 This file contains digital related 
 functions such as pinMode(),
 digitalWrite() and digitalRead().
+The inline versions in Arduino.h call
+these when the pin number isn't known
+at compile time.
 */
 
 #include "wiring_private.h"
@@ -34,15 +37,11 @@ void pinMode(uint8_t pin, uint8_t mode)
 
 void digitalWrite(uint8_t pin, uint8_t val)
 {
-  // SAFEMODE prevents you from inserting a pin number out of range, and disables PWM if turned on
+  // SAFEMODE prevents you from inserting a pin number out of range
   #if defined(SAFEMODE)
     if(pin > 5)
       return;
-    #if defined(SETUP_PWM)
-      if(pin < 2)
-        turnOffPWM(pin); // If it's a PWM pin, make sure PWM is off
-    #endif
-  #endif  
+  #endif
     
   if(val)
     PORTB |= _BV(pin);  // Set pin high
@@ -53,14 +52,10 @@ void digitalWrite(uint8_t pin, uint8_t val)
 
 uint8_t digitalRead(uint8_t pin)
 {
-  // SAFEMODE prevents you from inserting a pin number out of range, and disables PWM if turned on
+  // SAFEMODE prevents you from inserting a pin number out of range
   #ifdef SAFEMODE
     if(pin > 5)
       return 0;
-    #if defined(SETUP_PWM)
-      if(pin < 2)
-        turnOffPWM(pin); // If it's a PWM pin, make sure PWM is off
-    #endif
   #endif
   
   return !!(PINB & _BV(pin));
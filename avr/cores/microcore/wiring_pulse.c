@@ -24,9 +24,9 @@ uint32_t pulseIn(uint8_t pin, uint8_t state, uint32_t timeout)
 
   #if defined(SAFEMODE)
     if(pin > 5) // Return if pin number is too high
-      return;
+      return 0;
     if(pin < 2)
-      turnOffPWM(c); // If it's a PWM pin, make sure PWM is off
+      turnOffPWM(pin); // If it's a PWM pin, make sure PWM is off
   #endif
 
   // Convert the timeout from microseconds to a number of times through
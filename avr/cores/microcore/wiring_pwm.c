@@ -3,49 +3,130 @@ An Arduino core designed for ATtiny13
 File created and maintained by MCUdude
 https://github.com/MCUdude/MicroCore
 
-This file contains the PWM function
-analogWrite().
+This file contains the PWM functions
+analogWrite(), analogWriteFrequency()
+and analogWriteMode().
 */
 
 #include "wiring_private.h"
 #include "core_settings.h"
 
 
+// Leaves a compare output alone while tone(), Servo or a library owns it
 void turnOffPWM(uint8_t pin)
 {
-  if(pin == 0)
+  if(pin == 0 && !(timer0_owner & TIMER0_OCA))
     TCCR0A &= ~_BV(COM0A1);
-  else if(pin == 1)
+  else if(pin == 1 && !(timer0_owner & TIMER0_OCB))
     TCCR0A &= ~_BV(COM0B1);
 }
 
 
-void analogWrite(uint8_t pin, uint8_t val)
+// Default Timer0 clock select (TCCR0B bits 0..2) and waveform generation mode
+// (TCCR0A WGM bits, stored in bits 3..4), from core_settings.h
+#if defined(ENABLE_MICROS) || defined(PWM_PRESCALER_AUTO)
+  #if F_CPU >= 4800000L
+    #define PWM_DEFAULT_CS _BV(CS00) | _BV(CS01) // PWM frequency = (F_CPU/256) / 64
+  #else
+    #define PWM_DEFAULT_CS _BV(CS01)             // PWM frequency = (F_CPU/256) / 8
+  #endif
+#elif defined(PWM_PRESCALER_NONE)                // PWM frequency = (F_CPU/256) / 1
+  #define PWM_DEFAULT_CS _BV(CS00)
+#elif defined(PWM_PRESCALER_8)                   // PWM frequency = (F_CPU/256) / 8
+  #define PWM_DEFAULT_CS _BV(CS01)
+#elif defined(PWM_PRESCALER_64)                  // PWM frequency = (F_CPU/256) / 64
+  #define PWM_DEFAULT_CS _BV(CS00) | _BV(CS01)
+#elif defined(PWM_PRESCALER_256)                 // PWM frequency = (F_CPU/256) / 256
+  #define PWM_DEFAULT_CS _BV(CS02)
+#elif defined(PWM_PRESCALER_1024)                // PWM frequency = (F_CPU/256) / 1024
+  #define PWM_DEFAULT_CS _BV(CS00) | _BV(CS02)
+#endif
+
+// micros() counts Timer0 overflows as 256 ticks, which phase correct PWM doesn't give
+#if defined(PWM_PHASE_CORRECT) && defined(ENABLE_MICROS)
+  #error "PWM_PHASE_CORRECT can't be used together with micros(), use PWM_FAST or disable micros"
+#endif
+
+#if defined(PWM_PHASE_CORRECT)
+  #define PWM_DEFAULT_WGM PWM_MODE_PHASE_CORRECT
+#else
+  #define PWM_DEFAULT_WGM PWM_MODE_FAST
+#endif
+
+static uint8_t pwmSetup = (PWM_DEFAULT_CS) | (PWM_DEFAULT_WGM << 3);
+
+
+// Puts Timer0 in the PWM mode and prescaler analogWrite() uses, and drops any
+// compare output setting that isn't PWM (like a hardware toggled tone).
+// An owner that only counts overflows (TinyIRReceiver) keeps its prescaler
+// and gets fast PWM, so the overflow period stays 256 ticks
+static void pwmStart(void)
+{
+  if(timer0_owner != TIMER0_FREE)
+  {
+    TCCR0A = (TCCR0A & (_BV(COM0A1) | _BV(COM0B1))) | PWM_MODE_FAST;
+    return;
+  }
+  TCCR0A = (TCCR0A & (_BV(COM0A1) | _BV(COM0B1))) | (pwmSetup >> 3);
+  TCCR0B = pwmSetup & 0x07;
+}
+
+
+// Picks the prescaler that gets closest to hz. The switch points are the geometric
+// mean of the frequencies of two neighbouring prescalers, so no division is needed.
+// With fast PWM the frequencies are F_CPU / 256 / {1, 8, 64, 256, 1024}:
+//   9.6 MHz: 37.5 kHz, 4.69 kHz, 586 Hz, 146 Hz, 37 Hz
+//   1.2 MHz: 4.69 kHz, 586 Hz, 73 Hz, 18 Hz, 4.6 Hz
+// Phase correct PWM runs at half of that.
+// Ignored while anyone else owns Timer0, since they all depend on its clock
+void analogWriteFrequency(uint32_t hz)
 {
-  // Set Timer0 prescaler
+  // micros() needs its own prescaler
   #if !defined(ENABLE_MICROS)
-    #if defined(PWM_PRESCALER_AUTO)
-      #if F_CPU >= 4800000L
-        TCCR0B = _BV(CS00) | _BV(CS01); // PWM frequency = (F_CPU/256) / 64
-      #else
-        TCCR0B = _BV(CS01);             // PWM frequency = (F_CPU/256) / 8
-      #endif
-    #elif defined(PWM_PRESCALER_NONE)   // PWM frequency = (F_CPU/256) / 1
-      TCCR0B = _BV(CS00);
-    #elif defined(PWM_PRESCALER_8)      // PWM frequency = (F_CPU/256) / 8
-      TCCR0B = _BV(CS01);
-    #elif defined(PWM_PRESCALER_64)     // PWM frequency = (F_CPU/256) / 64
-      TCCR0B = _BV(CS00) | _BV(CS01);
-    #elif defined(PWM_PRESCALER_256)    // PWM frequency = (F_CPU/256) / 256
-      TCCR0B = _BV(CS02);
-    #elif defined(PWM_PRESCALER_1024)   // PWM frequency = (F_CPU/256) / 1024
-      TCCR0B = _BV(CS00) | _BV(CS02);
-    #endif
+    if(timer0_owner != TIMER0_FREE)
+      return;
+    if((pwmSetup >> 3) == PWM_MODE_PHASE_CORRECT)
+      hz <<= 1;
+
+    uint8_t cs;
+    if(hz >= F_CPU / 724)         // F_CPU / 256 / sqrt(8)
+      cs = _BV(CS00);
+    else if(hz >= F_CPU / 5793)   // F_CPU / 2048 / sqrt(8)
+      cs = _BV(CS01);
+    else if(hz >= F_CPU / 32768)  // F_CPU / 16384 / 2
+      cs = _BV(CS01) | _BV(CS00);
+    else if(hz >= F_CPU / 131072) // F_CPU / 65536 / 2
+      cs = _BV(CS02);
+    else
+      cs = _BV(CS02) | _BV(CS00);
+
+    pwmSetup = (pwmSetup & ~0x07) | cs;
+    pwmStart();
   #endif
+}
+
+
+// PWM_MODE_FAST or PWM_MODE_PHASE_CORRECT, other values are ignored. Phase
+// correct PWM makes Timer0 overflow half as often, so with micros() the mode
+// stays PWM_MODE_FAST. Like analogWriteFrequency() it's ignored while Timer0 is owned
+void analogWriteMode(uint8_t mode)
+{
+  #if !defined(ENABLE_MICROS)
+    if(timer0_owner != TIMER0_FREE || (mode != PWM_MODE_FAST && mode != PWM_MODE_PHASE_CORRECT))
+      return;
+    pwmSetup = (pwmSetup & 0x07) | (mode << 3);
+    pwmStart();
+  #endif
+}
+
 
+void analogWrite(uint8_t pin, uint8_t val)
+{
   // SAFEMODE prevents you from inserting a pin number out of range
   #ifdef SAFEMODE
-    DDRB |= _BV(pin & 0x02); // Set the correct pin as output
+    if(pin > 5)
+      return;
+    DDRB |= _BV(pin); // Set the pin as output
   #endif
 
   // Handle off condition
@@ -65,14 +146,25 @@ void analogWrite(uint8_t pin, uint8_t val)
   // Otherwise setup the appropriate timer compare
   else
   {
+    // Only PB0 and PB1 have PWM, the other pins can only be fully off or on
+    #ifdef SAFEMODE
+      if(pin > 1)
+        return;
+    #endif
+
+    // Ignored while tone(), Servo or a library runs Timer0 or uses this output.
+    // A receiver that only counts overflows leaves PWM alone
+    if(timer0_owner & (TIMER0_CLOCK | (pin ? TIMER0_OCB : TIMER0_OCA)))
+      return;
+
+    // Timer0 is only set up when it isn't running PWM already, like the first
+    // time or after tone(). Otherwise analogWrite() only touches OCR0x and COM0x1
+    if((TCCR0B & _BV(WGM02)) || !(TCCR0A & _BV(WGM00)))
+      pwmStart();
+
     if(pin == 1)
     {
-      // Set waveform generation mode and output number
-      #if defined(PWM_FAST)
-        TCCR0A |= _BV(WGM00) | _BV(WGM01) | _BV(COM0B1);
-      #elif defined(PWM_PHASE_CORRECT)
-        TCCR0A |= _BV(WGM00) | _BV(COM0B1);
-      #endif
+      TCCR0A |= _BV(COM0B1); // Connect the output
       OCR0B = val;
     }
 
@@ -83,12 +175,7 @@ void analogWrite(uint8_t pin, uint8_t val)
     else // We're saving a few bytes by not checking if pin = 0
     #endif
     {
-      // Set waveform generation mode and output number
-      #if defined(PWM_FAST)
-        TCCR0A |= _BV(WGM00) | _BV(WGM01) | _BV(COM0A1);
-      #elif defined(PWM_PHASE_CORRECT)
-        TCCR0A |= _BV(WGM00) | _BV(COM0A1);
-      #endif
+      TCCR0A |= _BV(COM0A1); // Connect the output
       OCR0A = val;
     }
   }
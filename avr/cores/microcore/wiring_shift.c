@@ -5,44 +5,162 @@ Modified and maintained by MCUdude
 https://github.com/MCUdude/MicroCore
 
 This file contains the shift related 
-functions shiftIn() and shiftOut().
+functions shiftIn(), shiftOut(),
+shiftInBuffer() and shiftOutBuffer().
 */
 
 #include "wiring_private.h"
+#include "core_settings.h"
+
+
+// Nops between raising SCK and reading the data pin. An HX711 needs up to 100 ns
+// to put out the next bit, and PINB latches the pin half a cycle before the in
+// instruction, so the nop and these have to last 100 ns plus half a cycle
+#define SHIFT_SAMPLE_PAD (F_CPU > 5000000UL ? (F_CPU - 5000000UL + 9999999UL) / 10000000UL : 0)
+
+// SCK also has to stay high for at least 200 ns, which is 3 cycles plus these
+#define SHIFT_HIGH_PAD ((F_CPU + 4999999UL) / 5000000UL > 3 ? (F_CPU + 4999999UL) / 5000000UL - 3 : 0)
+
+// 1 at 8 to 12 MHz, 2 at 16 and 20 MHz
+#define SHIFT_PAD (SHIFT_SAMPLE_PAD > SHIFT_HIGH_PAD ? SHIFT_SAMPLE_PAD : SHIFT_HIGH_PAD)
+
+// Reads 8 bits with one unrolled asm sequence, 7 cycles per bit (plus SHIFT_PAD).
+// SCK has to be low on entry, and is high for 3 cycles per bit (plus SHIFT_PAD)
+static inline uint8_t shiftInUnrolled(uint8_t datapinMask, uint8_t clkpinMask, uint8_t bitOrder)
+{
+  uint8_t value = 0;
+  uint8_t tmp;
+  if(bitOrder == MSBFIRST)
+  {
+    asm volatile(
+      ".rept 8                   \n"
+      "out  %[pinb], %[clk]      \n" // SCK high
+      "nop                       \n" // Give the slave time to drive the data pin
+      ".rept %[pad]              \n"
+      "  nop                     \n"
+      ".endr                     \n"
+      "in   %[tmp], %[pinb]      \n"
+      "out  %[pinb], %[clk]      \n" // SCK low
+      "and  %[tmp], %[data]      \n"
+      "cp   __zero_reg__, %[tmp] \n" // Carry = data bit
+      "rol  %[val]               \n"
+      ".endr                     \n"
+      : [val] "+r" (value), [tmp] "=&r" (tmp)
+      : [pinb] "I" (_SFR_IO_ADDR(PINB)), [clk] "r" (clkpinMask), [data] "r" (datapinMask),
+        [pad] "n" (SHIFT_PAD)
+    );
+  }
+  else
+  {
+    asm volatile(
+      ".rept 8                   \n"
+      "out  %[pinb], %[clk]      \n" // SCK high
+      "nop                       \n" // Give the slave time to drive the data pin
+      ".rept %[pad]              \n"
+      "  nop                     \n"
+      ".endr                     \n"
+      "in   %[tmp], %[pinb]      \n"
+      "out  %[pinb], %[clk]      \n" // SCK low
+      "and  %[tmp], %[data]      \n"
+      "cp   __zero_reg__, %[tmp] \n" // Carry = data bit
+      "ror  %[val]               \n"
+      ".endr                     \n"
+      : [val] "+r" (value), [tmp] "=&r" (tmp)
+      : [pinb] "I" (_SFR_IO_ADDR(PINB)), [clk] "r" (clkpinMask), [data] "r" (datapinMask),
+        [pad] "n" (SHIFT_PAD)
+    );
+  }
+  return value;
+}
+
+
+// Writes 8 bits with one unrolled asm sequence, 5 cycles per bit.
+// portLow is PORTB with data and clock low, portHigh is the same with data high.
+// Every out to PORTB sets the data bit and pulls SCK low, the PINB write raises SCK
+static inline void shiftOutUnrolled(uint8_t value, uint8_t portLow, uint8_t portHigh, uint8_t clkpinMask, uint8_t bitOrder)
+{
+  uint8_t tmp;
+  if(bitOrder == MSBFIRST)
+  {
+    asm volatile(
+      ".irp bit,7,6,5,4,3,2,1,0  \n"
+      "mov  %[tmp], %[low]       \n"
+      "sbrc %[val], \\bit        \n"
+      "mov  %[tmp], %[high]      \n"
+      "out  %[portb], %[tmp]     \n" // Data out, SCK low
+      "out  %[pinb], %[clk]      \n" // SCK high
+      ".endr                     \n"
+      : [tmp] "=&r" (tmp)
+      : [val] "r" (value), [low] "r" (portLow), [high] "r" (portHigh), [clk] "r" (clkpinMask),
+        [portb] "I" (_SFR_IO_ADDR(PORTB)), [pinb] "I" (_SFR_IO_ADDR(PINB))
+    );
+  }
+  else
+  {
+    asm volatile(
+      ".irp bit,0,1,2,3,4,5,6,7  \n"
+      "mov  %[tmp], %[low]       \n"
+      "sbrc %[val], \\bit        \n"
+      "mov  %[tmp], %[high]      \n"
+      "out  %[portb], %[tmp]     \n" // Data out, SCK low
+      "out  %[pinb], %[clk]      \n" // SCK high
+      ".endr                     \n"
+      : [tmp] "=&r" (tmp)
+      : [val] "r" (value), [low] "r" (portLow), [high] "r" (portHigh), [clk] "r" (clkpinMask),
+        [portb] "I" (_SFR_IO_ADDR(PORTB)), [pinb] "I" (_SFR_IO_ADDR(PINB))
+    );
+  }
+}
 
 
 uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder)
 {  
   #if defined(SAFEMODE)
-    if(clockPin > 5 || datapin > 5) // Return if pin number is too high
-      return;
+    if(clockPin > 5 || dataPin > 5) // Return if pin number is too high
+      return 0;
     if(clockPin < 2)
       turnOffPWM(clockPin); // If it's a PWM pin, make sure PWM is off
     if(dataPin < 2)
       turnOffPWM(dataPin);  // If it's a PWM pin, make sure PWM is off
   #endif  
- 
-  uint8_t value = 0;
-  uint8_t i = 8;
-  do
-  {
-    digitalWrite(clockPin, HIGH);
-    if(bitOrder == MSBFIRST) 
-      value <<= 1;
-    else 
-      value >>= 1;
-    if(digitalRead(dataPin))
-    { 
-      if(bitOrder == MSBFIRST)
-        value |= 0x01;
-      else 
-        value |= 0x80;
-    }  
-    digitalWrite(clockPin, LOW);
-  }
-  while(--i);
- 
-  return value;
+
+  const uint8_t datapinMask = _BV(dataPin);
+  const uint8_t clkpinMask = _BV(clockPin);
+  PORTB &= ~clkpinMask; // Clock pin low, so the first PINB toggle is a rising edge
+
+  #if defined(SHIFT_UNROLLED)
+    return shiftInUnrolled(datapinMask, clkpinMask, bitOrder);
+  #else
+    uint8_t value = 0;
+    uint8_t i = 8;
+
+    // Test the bit order once, not for every bit
+    if(bitOrder == MSBFIRST)
+    {
+      do
+      {
+        PINB = clkpinMask; // Clock pin high
+        value <<= 1;
+        if(PINB & datapinMask)
+          value |= 0x01;
+        PINB = clkpinMask; // Clock pin low
+      }
+      while(--i);
+    }
+    else
+    {
+      do
+      {
+        PINB = clkpinMask; // Clock pin high
+        value >>= 1;
+        if(PINB & datapinMask)
+          value |= 0x80;
+        PINB = clkpinMask; // Clock pin low
+      }
+      while(--i);
+    }
+    return value;
+  #endif
 }
 
 
@@ -84,3 +202,77 @@ void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t value
   }
   while(--i);
 }
+
+
+// Reads length bytes into buf. The pins are set up once, and every byte
+// is read with the unrolled sequence from shiftInUnrolled()
+void shiftInBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t *buf, uint8_t length)
+{
+  if(length == 0) // Nothing to read
+    return;
+
+  #if defined(SAFEMODE)
+    if(clockPin > 5 || dataPin > 5) // Return if pin number is too high
+      return;
+    if(clockPin < 2)
+      turnOffPWM(clockPin); // If it's a PWM pin, make sure PWM is off
+    if(dataPin < 2)
+      turnOffPWM(dataPin);  // If it's a PWM pin, make sure PWM is off
+  #endif
+
+  const uint8_t datapinMask = _BV(dataPin);
+  const uint8_t clkpinMask = _BV(clockPin);
+  PORTB &= ~clkpinMask; // Clock pin low, so the first PINB toggle is a rising edge
+
+  // Test the bit order once, not for every byte
+  if(bitOrder == MSBFIRST)
+  {
+    do
+      *buf++ = shiftInUnrolled(datapinMask, clkpinMask, MSBFIRST);
+    while(--length);
+  }
+  else
+  {
+    do
+      *buf++ = shiftInUnrolled(datapinMask, clkpinMask, LSBFIRST);
+    while(--length);
+  }
+}
+
+
+// Writes length bytes from buf. The pins are set up once, and every byte
+// is written with the unrolled sequence from shiftOutUnrolled()
+void shiftOutBuffer(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, const uint8_t *buf, uint8_t length)
+{
+  if(length == 0) // Nothing to write
+    return;
+
+  #if defined(SAFEMODE)
+    if(clockPin > 5 || dataPin > 5) // Return if pin number is too high
+      return;
+    if(clockPin < 2)
+      turnOffPWM(clockPin); // If it's a PWM pin, make sure PWM is off
+    if(dataPin < 2)
+      turnOffPWM(dataPin);  // If it's a PWM pin, make sure PWM is off
+  #endif
+
+  const uint8_t datapinMask = _BV(dataPin);
+  const uint8_t clkpinMask = _BV(clockPin);
+  const uint8_t portLow = (PORTB &= ~(datapinMask | clkpinMask));
+  const uint8_t portHigh = portLow | datapinMask;
+
+  // Test the bit order once, not for every byte
+  if(bitOrder == MSBFIRST)
+  {
+    do
+      shiftOutUnrolled(*buf++, portLow, portHigh, clkpinMask, MSBFIRST);
+    while(--length);
+  }
+  else
+  {
+    do
+      shiftOutUnrolled(*buf++, portLow, portHigh, clkpinMask, LSBFIRST);
+    while(--length);
+  }
+  PORTB = portLow; // Clock and data pin low
+}
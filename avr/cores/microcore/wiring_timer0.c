@@ -0,0 +1,80 @@
+/*** MicroCore - wiring_timer0.c ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+This file keeps track of who owns Timer0, and
+contains the Timer0 setup shared by the sample
+based audio libraries (TinySynth, TinyDDS and
+TinySample): fast PWM without a prescaler on
+OC0A (PB0), with the compare match B interrupt
+at BOTTOM as the sample clock.
+*/
+
+#include "wiring_private.h"
+#include "core_settings.h"
+
+// One of the TIMER0_* owners from Arduino.h. tone_wdt.S writes it too.
+// The low nibble of an owner holds the TIMER0_CLOCK/OCA/OCB/OVF resources
+// it takes, which is what analogWrite() and friends check before touching
+// Timer0. Every owner needs the clock or the overflow period, so there is
+// only ever one of them
+volatile uint8_t timer0_owner;
+
+
+// Returns 1 if Timer0 is free or already belongs to owner, and makes it owner's.
+// Returns 0 if another library has it, which should then leave Timer0 alone.
+// Only tone() gives it back from an interrupt, so no cli() is needed here
+uint8_t timer0Claim(uint8_t owner)
+{
+  if(timer0_owner != TIMER0_FREE && timer0_owner != owner)
+    return 0;
+  timer0_owner = owner;
+  return 1;
+}
+
+
+// Gives Timer0 back to PWM and micros(), if owner has it
+void timer0Release(uint8_t owner)
+{
+  if(timer0_owner == owner)
+    timer0_owner = TIMER0_FREE;
+}
+
+
+// Takes over Timer0 and starts the sample interrupt, with OC0A at level.
+// The audio libraries refuse to build with micros() enabled, since at this
+// rate the overflow interrupt would cost more than the sample interrupt.
+// Returns 0 and does nothing if another library owns Timer0
+uint8_t timer0AudioBegin(uint8_t level)
+{
+  if(!timer0Claim(TIMER0_AUDIO))
+    return 0;
+  DDRB |= _BV(PB0);
+  cli();
+  TCCR0B = 0;
+  TCNT0  = 0;
+  OCR0A  = level;
+  OCR0B  = 0; // The sample interrupt runs at BOTTOM
+  TCCR0A = _BV(COM0A1) | _BV(WGM01) | _BV(WGM00); // Fast PWM, non-inverting OC0A
+  TIFR0  = _BV(OCF0B);
+  TIMSK0 = _BV(OCIE0B);
+  TCCR0B = _BV(CS00);
+  sei(); // Audio needs interrupts, so don't restore SREG
+  return 1;
+}
+
+
+// Stops the sample interrupt and leaves PB0 low. Timer0 keeps running as it is
+void timer0AudioEnd(void)
+{
+  if(timer0_owner != TIMER0_AUDIO)
+    return;
+  uint8_t oldSREG = SREG;
+  cli();
+  TIMSK0 &= ~_BV(OCIE0B);
+  TCCR0A &= ~(_BV(COM0A1) | _BV(COM0A0));
+  PORTB &= ~_BV(PB0);
+  timer0_owner = TIMER0_FREE;
+  SREG = oldSREG;
+}
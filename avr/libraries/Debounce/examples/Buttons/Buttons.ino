@@ -0,0 +1,28 @@
+/*
+  Debounced buttons
+
+  Two push buttons are connected between PB3/PB4 and GND.
+  They are debounced in the background by the watchdog
+  timer interrupt, so loop() never has to wait.
+  Pressing the button on PB3 toggles the LED on PB2, and
+  releasing the button on PB4 toggles it as well.
+*/
+
+#include <Debounce.h>
+
+void setup()
+{
+  pinMode(LED_BUILTIN, OUTPUT);
+  Debounce.begin(_BV(PB3) | _BV(PB4)); // Inputs with pullups
+}
+
+void loop()
+{
+  if(Debounce.pressed(_BV(PB3)))
+    PINB = _BV(LED_BUILTIN); // Toggle LED
+
+  if(Debounce.released(_BV(PB4)))
+    PINB = _BV(LED_BUILTIN); // Toggle LED
+
+  // Other work can be done here without missing a button press
+}
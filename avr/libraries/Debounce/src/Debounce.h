@@ -0,0 +1,65 @@
+/*** MicroCore - Debounce.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Background button debouncing for all PORTB pins.
+The work is done in Debounce.S, which runs from
+the watchdog tick used by millis(), so debouncing
+never blocks the sketch. Pins are expected to be
+active low (button between pin and GND).
+
+Only one library can hook the watchdog tick.
+Don't use Debounce together with a sketch that
+defines its own WDT_vect.
+*/
+
+#ifndef Debounce_h
+#define Debounce_h
+
+#include <Arduino.h>
+
+extern "C"
+{
+  // Defined in Debounce.S, bit n is PBn
+  extern volatile uint8_t debounce_state;
+  extern volatile uint8_t debounce_pressed;
+  extern volatile uint8_t debounce_released;
+}
+
+struct DebounceClass
+{
+  // Set the pins in mask as inputs with pullups enabled
+  void begin(uint8_t mask)
+  {
+    DDRB &= ~mask;
+    PORTB |= mask;
+  }
+
+  // Debounced level of the pins in mask, 1 = pressed
+  uint8_t state(uint8_t mask = 0x3F) { return debounce_state & mask; }
+
+  // Returns the pins in mask that have been pressed since the last call,
+  // and clears their flags
+  uint8_t pressed(uint8_t mask = 0x3F) { return takeFlags(debounce_pressed, mask); }
+
+  // Returns the pins in mask that have been released since the last call,
+  // and clears their flags
+  uint8_t released(uint8_t mask = 0x3F) { return takeFlags(debounce_released, mask); }
+
+  private:
+    // The WDT ISR modifies the flags, so read and clear them with interrupts off
+    static uint8_t takeFlags(volatile uint8_t &flags, uint8_t mask)
+    {
+      uint8_t oldSREG = SREG;
+      cli();
+      uint8_t f = flags & mask;
+      flags ^= f;
+      SREG = oldSREG;
+      return f;
+    }
+};
+
+static DebounceClass Debounce;
+
+#endif
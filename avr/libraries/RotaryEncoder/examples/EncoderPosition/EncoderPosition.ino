@@ -0,0 +1,30 @@
+/*
+  Rotary encoder position
+
+  A mechanical rotary encoder is connected to PB3 and PB4,
+  with the common pin to GND. The encoder is decoded in the
+  background by the pin change interrupt.
+
+  The encoder position is printed over serial every time it
+  changes. Most encoders give four counts per detent.
+*/
+
+#include <RotaryEncoder.h>
+
+int16_t lastPosition = 0;
+
+void setup()
+{
+  Serial.begin();
+  RotaryEncoder.begin(PB3, PB4);
+}
+
+void loop()
+{
+  int16_t position = RotaryEncoder.read();
+  if(position != lastPosition)
+  {
+    lastPosition = position;
+    Serial.println(position / 4);
+  }
+}
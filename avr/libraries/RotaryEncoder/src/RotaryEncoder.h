@@ -0,0 +1,108 @@
+/*** MicroCore - RotaryEncoder.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Quadrature rotary encoder decoder for any two
+PORTB pins. Decoding is done by the pin change
+interrupt in RotaryEncoder.S, so no steps are
+lost while loop() is busy. The position counts
+every edge, which is four counts per detent on
+most mechanical encoders.
+
+Every edge costs 70 clock cycles, which gives
+these max edge rates (with no other interrupts):
+
+| Clock   | Edges/s |
+|---------|---------|
+| 20 MHz  | 285714  |
+| 16 MHz  | 228571  |
+| 12 MHz  | 171428  |
+| 9.6 MHz | 137142  |
+| 8 MHz   | 114285  |
+| 4.8 MHz | 68571   |
+| 1.2 MHz | 17142   |
+| 1 MHz   | 14285   |
+| 600 kHz | 8571    |
+| 128 kHz | 1828    |
+
+The pin change interrupt can't be used for
+anything else while the encoder is running.
+*/
+
+#ifndef RotaryEncoder_h
+#define RotaryEncoder_h
+
+#include <Arduino.h>
+
+extern "C"
+{
+  // Defined in RotaryEncoder.S
+  extern volatile int16_t encoder_position;
+  extern volatile uint8_t encoder_state;
+  extern uint8_t encoder_maskA;
+  extern uint8_t encoder_maskB;
+}
+
+struct RotaryEncoderClass
+{
+  // Set up the encoder pins as inputs with pullups and start decoding
+  void begin(uint8_t pinA, uint8_t pinB)
+  {
+    const uint8_t maskA = _BV(pinA);
+    const uint8_t maskB = _BV(pinB);
+
+    DDRB &= ~(maskA | maskB);
+    PORTB |= maskA | maskB;
+
+    cli();
+    encoder_maskA = maskA;
+    encoder_maskB = maskB;
+    // Start from the current pin state so the first edge is counted correctly
+    encoder_state = (((PINB & maskA) ? 0x01 : 0) | ((PINB & maskB) ? 0x02 : 0)) << 2;
+    PCMSK |= maskA | maskB;
+    GIFR = _BV(PCIF);
+    GIMSK |= _BV(PCIE);
+    sei(); // The encoder needs interrupts, so don't restore SREG
+  }
+
+  // Stop decoding. The position is kept
+  void end()
+  {
+    PCMSK &= ~(encoder_maskA | encoder_maskB);
+    GIMSK &= ~_BV(PCIE);
+  }
+
+  // Current position. Reading two bytes has to be done with interrupts off
+  int16_t read()
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    int16_t pos = encoder_position;
+    SREG = oldSREG;
+    return pos;
+  }
+
+  void write(int16_t pos)
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    encoder_position = pos;
+    SREG = oldSREG;
+  }
+
+  // Returns the steps since the last call and sets the position back to zero
+  int16_t readAndReset()
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    int16_t pos = encoder_position;
+    encoder_position = 0;
+    SREG = oldSREG;
+    return pos;
+  }
+};
+
+static RotaryEncoderClass RotaryEncoder;
+
+#endif
@@ -0,0 +1,43 @@
+/*
+  Sweep
+
+  Sweeps a servo from 0 to 180 degrees and back, while a
+  second servo follows a potentiometer. The pulses are made
+  by Timer0 in the background, so the sketch only sets the
+  positions.
+
+  The circuit:
+  * Servo signal on digital pin 0 (OC0A)
+  * Servo signal on digital pin 1 (OC0B)
+  * Potentiometer wiper on analog pin 2, ends to VCC and GND
+  * Servo power from a separate 5 V supply, GND shared
+*/
+
+#include <Servo.h>
+
+Servo sweeper;
+Servo follower;
+
+uint8_t angle;
+int8_t step = 1;
+
+
+void setup()
+{
+  sweeper.attach(PB0);
+  follower.attach(PB1);
+}
+
+
+void loop()
+{
+  sweeper.write(angle);
+  angle += step;
+  if(angle == 0 || angle == 180)
+    step = -step;
+
+  // 0..1023 to 0..180 degrees, without a division
+  follower.write((uint16_t)analogRead(A2) * 45 >> 8);
+
+  delay(15);
+}
@@ -0,0 +1,204 @@
+/*** MicroCore - Servo.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Drives one or two hobby servos on OC0A (PB0) and
+OC0B (PB1), with the same API as the Arduino
+Servo library. Both edges of every pulse are
+made by Timer0 compare matches, so the pulse
+length doesn't depend on the code that runs.
+
+A frame starts on every millis() watchdog tick,
+about every 19 ms. The pulse is then counted in
+256 tick steps by a short compare interrupt, see
+Servo.S. Ticks per microsecond and interrupts
+per channel and frame for a 2.4 ms pulse:
+
+| Clock   | Prescaler | Ticks/us | Interrupts |
+|---------|-----------|----------|------------|
+| 20 MHz  | 64        | 0.31     | 2          |
+| 16 MHz  | 64        | 0.25     | 2          |
+| 12 MHz  | 8         | 1.5      | 14         |
+| 9.6 MHz | 8         | 1.2      | 11         |
+| 8 MHz   | 8         | 1        | 9          |
+| 4.8 MHz | 8         | 0.6      | 5          |
+| 1.2 MHz | 1         | 1.2      | 11         |
+| 1 MHz   | 1         | 1        | 9          |
+| 600 kHz | 1         | 0.6      | 5          |
+| 128 kHz | 1         | 0.13     | 1          |
+
+Every interrupt is 27 to 32 cycles, so two
+servos cost well below 1% of the CPU. Except at
+128 kHz, there are at least 250 steps between
+1 and 2 ms.
+
+Servo takes over Timer0 from the first attach()
+until the last detach(), and analogWrite() is
+ignored until then. Servo.S has both compare
+interrupts, so a sketch that also uses tone()
+(TIM0_COMPA_vect in the core) or TinySoftPWM,
+TinySynth, TinyDDS or TinySample
+(TIM0_COMPB_vect) fails to link, and enabling
+micros() is a compile error. The Timer0
+libraries without compare interrupts,
+TinyIRSender and TinyIRReceiver, are checked
+at runtime: attach() fails while one of them
+owns Timer0, and their send functions and
+begin() return false while a servo is attached.
+A cli() section of more than 256 ticks
+during a pulse makes it 256 ticks longer.
+
+attach(pin, min, max) and read() aren't there.
+The pulse range is SERVO_MIN_US..SERVO_MAX_US,
+and both can be defined before including
+Servo.h.
+
+  Servo servo;
+  servo.attach(PB0);
+  servo.write(90);
+*/
+
+#ifndef Servo_h
+#define Servo_h
+
+#include <Arduino.h>
+
+// Servo changes the prescaler and stops Timer0 between frames
+#if defined(ENABLE_MICROS)
+  #error "Servo can't be used together with micros(), disable micros"
+#endif
+
+#ifndef SERVO_MIN_US
+  #define SERVO_MIN_US 544  // Pulse length at 0 degrees
+#endif
+#ifndef SERVO_MAX_US
+  #define SERVO_MAX_US 2400 // Pulse length at 180 degrees
+#endif
+
+#define INVALID_SERVO 255
+
+// Timer0 prescaler, must match SERVO_CS in Servo.S
+#if F_CPU >= 16000000L
+  #define SERVO_PRESCALER 64
+#elif F_CPU >= 4800000L
+  #define SERVO_PRESCALER 8
+#else
+  #define SERVO_PRESCALER 1
+#endif
+
+extern "C"
+{
+  // Defined in Servo.S
+  extern volatile uint8_t servo_set;
+  extern volatile uint8_t servo_start;
+  extern volatile uint8_t servo_timsk;
+  extern volatile uint8_t servo_ocr[2];
+  extern volatile uint8_t servo_count[2];
+}
+
+class Servo
+{
+  public:
+    // Returns the channel (0 for PB0, 1 for PB1), or INVALID_SERVO for any other pin
+    // or while another library owns Timer0. The servo is centered until the first write()
+    uint8_t attach(uint8_t pin)
+    {
+      if(pin > PB1 || !timer0Claim(TIMER0_SERVO))
+        return INVALID_SERVO;
+      channel = pin;
+      PORTB &= ~_BV(pin);
+      DDRB |= _BV(pin);
+      uint8_t oldSREG = SREG;
+      cli();
+      if(!servo_set)
+      {
+        // Normal mode, free running. Frames are started by the watchdog tick
+        TCCR0B = 0;
+        TCCR0A = 0;
+        TCCR0B = (SERVO_PRESCALER == 64) ? _BV(CS01) | _BV(CS00)
+               : (SERVO_PRESCALER == 8)  ? _BV(CS01) : _BV(CS00);
+      }
+      writeMicroseconds((SERVO_MIN_US + SERVO_MAX_US) / 2);
+      servo_set |= setBits();
+      SREG = oldSREG;
+      return channel;
+    }
+
+    // Stops the pulses, the pin stays low. A pulse that's playing is cut short.
+    // Timer0 is free again once no servo is attached
+    void detach()
+    {
+      if(!attached())
+        return;
+      uint8_t oldSREG = SREG;
+      cli();
+      servo_set &= ~setBits();
+      servo_start &= ~setBits();
+      servo_timsk &= ~ocie();
+      TIMSK0 &= ~ocie();
+      TCCR0A &= ~setBits();
+      if(!servo_set)
+        timer0Release(TIMER0_SERVO);
+      SREG = oldSREG;
+    }
+
+    bool attached()
+    {
+      return channel != INVALID_SERVO && (servo_set & setBits());
+    }
+
+    // An angle from 0 to 180 degrees. Like the Arduino library, values of
+    // SERVO_MIN_US and up are taken as a pulse length in microseconds
+    void write(int value)
+    {
+      if(value >= SERVO_MIN_US)
+        return writeMicroseconds(value);
+      if(value < 0)
+        value = 0;
+      else if(value > 180)
+        value = 180;
+      writeMicroseconds(SERVO_MIN_US + (((uint32_t)value * usPerDegree) >> 8));
+    }
+
+    // The new pulse length is used from the next frame on
+    void writeMicroseconds(uint16_t us)
+    {
+      if(channel == INVALID_SERVO)
+        return;
+      if(us < SERVO_MIN_US)
+        us = SERVO_MIN_US;
+      else if(us > SERVO_MAX_US)
+        us = SERVO_MAX_US;
+      const uint16_t ticks = ((uint32_t)us * ticksPerUs) >> 8;
+
+      uint8_t oldSREG = SREG;
+      cli();
+      servo_ocr[channel] = ticks;
+      servo_count[channel] = (ticks - 1) >> 8;
+      if(servo_count[channel])
+      {
+        servo_start |= setBits();
+        servo_timsk |= ocie();
+      }
+      else // Done in one compare match, so clear on the first one
+      {
+        servo_start = (servo_start & ~setBits()) | clearBit();
+        servo_timsk &= ~ocie();
+      }
+      SREG = oldSREG;
+    }
+
+  private:
+    // Both in 1/256 units, rounded to nearest
+    static constexpr uint16_t ticksPerUs  = (F_CPU / SERVO_PRESCALER * 256UL + 500000UL) / 1000000UL;
+    static constexpr uint16_t usPerDegree = ((SERVO_MAX_US - SERVO_MIN_US) * 256UL + 90) / 180;
+
+    uint8_t setBits()  { return channel ? _BV(COM0B1) | _BV(COM0B0) : _BV(COM0A1) | _BV(COM0A0); }
+    uint8_t clearBit() { return channel ? _BV(COM0B1) : _BV(COM0A1); }
+    uint8_t ocie()     { return channel ? _BV(OCIE0B) : _BV(OCIE0A); }
+
+    uint8_t channel = INVALID_SERVO;
+};
+
+#endif
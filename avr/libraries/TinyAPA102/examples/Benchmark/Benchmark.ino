@@ -0,0 +1,56 @@
+/*
+  APA102 frame rate benchmark
+
+  Writes 100 frames of a moving gradient to a 150 LED APA102
+  strip and prints the frame rate once. Every pixel is computed
+  by a callback while the strip is written, so no frame buffer
+  is used. Run it at each clock speed to compare.
+
+  The circuit:
+  * Strip DI (data) to digital pin 0 (MOSI)
+  * Strip CI (clock) to digital pin 2 (SCK)
+  * Strip GND to GND and 5V to a supply that can drive the LEDs
+  * Serial TX is also on digital pin 0, see the MicroCore readme.
+    The serial monitor shows some garbage while the frames are
+    written, and the result when they're done.
+*/
+
+#include <TinyAPA102.h>
+
+const uint16_t numLeds = 150;
+const uint8_t numFrames = 100;
+
+TinyAPA102<> strip;
+uint8_t offset;
+
+
+// Blue to red gradient that moves one step per frame
+void gradient(uint16_t index, uint8_t *bgr)
+{
+  uint8_t level = (uint8_t)index + offset;
+  bgr[0] = ~level;
+  bgr[1] = 0;
+  bgr[2] = level;
+}
+
+
+void setup()
+{
+  strip.begin(4); // Low brightness
+
+  uint32_t start = millis();
+  for(uint8_t i = 0; i < numFrames; i++)
+  {
+    strip.write(numLeds, gradient);
+    offset++;
+  }
+  uint32_t elapsed = millis() - start;
+
+  Serial.print(F("\nFrames per second: "));
+  Serial.println(numFrames * 1000UL / elapsed);
+}
+
+
+void loop()
+{
+}
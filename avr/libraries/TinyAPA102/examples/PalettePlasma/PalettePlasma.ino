@@ -0,0 +1,53 @@
+/*
+  Palette plasma
+
+  Animates a 300 LED APA102 strip with colors picked from an
+  8 entry palette in flash. Each LED only costs a palette index
+  computed on the fly, so the strip uses no RAM for pixels.
+
+  The circuit:
+  * Strip DI (data) to digital pin 0 (MOSI)
+  * Strip CI (clock) to digital pin 2 (SCK)
+  * Strip GND to GND and 5V to a supply that can drive the LEDs
+*/
+
+#include <TinyAPA102.h>
+
+const uint16_t numLeds = 300;
+
+// B, G, R
+const uint8_t palette[] PROGMEM =
+{
+  255,   0,   0,
+  255,  64,   0,
+  128, 128,   0,
+    0, 255,   0,
+    0, 128, 128,
+    0,  64, 255,
+   64,   0, 255,
+  128,   0, 128,
+};
+
+TinyAPA102<> strip;
+uint8_t phase;
+
+
+uint8_t plasma(uint16_t index)
+{
+  uint8_t i = index;
+  return ((i >> 3) + (i >> 5) + phase) & 0x07;
+}
+
+
+void setup()
+{
+  strip.begin(8);
+}
+
+
+void loop()
+{
+  strip.write(numLeds, plasma, palette);
+  phase++;
+  delay(50);
+}
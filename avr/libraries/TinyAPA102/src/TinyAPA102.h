@@ -0,0 +1,137 @@
+/*** MicroCore - TinyAPA102.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+APA102/DotStar (and SK9822) LED strip driver on
+the TinySPI bit-bang core. APA102 LEDs are
+clocked, so there's no timing to meet and any
+F_CPU works. There's no frame buffer either:
+every pixel is computed while the strip is
+written, from one of:
+  - a callback that fills in the color
+  - a callback that returns an index into a
+    PROGMEM palette
+  - a PROGMEM pattern repeated along the strip
+so strips of hundreds of LEDs need no RAM at all.
+
+Uses the TinySPI pins: data (DI) on MOSI (PB0)
+and clock (CI) on SCK (PB2). SCK runs at
+F_CPU / Divider, F_CPU / 8 by default.
+
+Colors are B, G, R byte arrays, the order the
+LEDs expect them in. Every pixel also gets the
+5-bit global brightness (0..31) given to begin().
+
+The upper limit of the frame rate is set by SCK:
+a strip of n LEDs needs (9 + 4n + n/16) bytes.
+For 150 LEDs at F_CPU / 8 that's 4 ms at 9.6 MHz.
+The Benchmark example measures the real frame
+rate, including the time spent in the callback.
+*/
+
+#ifndef TinyAPA102_h
+#define TinyAPA102_h
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include <TinySPI.h>
+
+// Fills bgr (3 bytes) with the color of LED number index
+typedef void (*TinyAPA102Generator)(uint16_t index, uint8_t *bgr);
+
+// Returns the palette entry to use for LED number index
+typedef uint8_t (*TinyAPA102PaletteGenerator)(uint16_t index);
+
+template <uint8_t Divider = 8>
+struct TinyAPA102
+{
+  typedef TinySPI<SPI_MODE0, MSBFIRST, Divider> Bus;
+
+  void begin(uint8_t brightness = 31)
+  {
+    Bus::begin();
+    setBrightness(brightness);
+  }
+
+  void setBrightness(uint8_t brightness)
+  {
+    header = 0xE0 | (brightness & 0x1F);
+  }
+
+  // Every LED computed by generator
+  void write(uint16_t count, TinyAPA102Generator generator)
+  {
+    uint8_t bgr[3];
+    startFrame();
+    for(uint16_t i = 0; i < count; i++)
+    {
+      generator(i, bgr);
+      pixel(bgr[0], bgr[1], bgr[2]);
+    }
+    endFrame(count);
+  }
+
+  // Every LED is palette[generator(i)], palette is a PROGMEM array of B, G, R triplets
+  void write(uint16_t count, TinyAPA102PaletteGenerator generator, const uint8_t *palette)
+  {
+    startFrame();
+    for(uint16_t i = 0; i < count; i++)
+    {
+      const uint8_t *color = palette + generator(i) * 3;
+      pixel(pgm_read_byte(color), pgm_read_byte(color + 1), pgm_read_byte(color + 2));
+    }
+    endFrame(count);
+  }
+
+  // A PROGMEM pattern of length B, G, R triplets, repeated over count LEDs
+  void writeP(uint16_t count, const uint8_t *pattern, uint8_t length)
+  {
+    if(length == 0)
+      return;
+    const uint8_t *color = pattern;
+    uint8_t n = length;
+    startFrame();
+    for(uint16_t i = 0; i < count; i++)
+    {
+      pixel(pgm_read_byte(color), pgm_read_byte(color + 1), pgm_read_byte(color + 2));
+      color += 3;
+      if(--n == 0)
+      {
+        color = pattern;
+        n = length;
+      }
+    }
+    endFrame(count);
+  }
+
+  // Building blocks for a custom frame: startFrame(), one pixel() per LED, endFrame()
+  static void startFrame()
+  {
+    for(uint8_t i = 0; i < 4; i++)
+      Bus::transferOut(0x00);
+  }
+
+  void pixel(uint8_t b, uint8_t g, uint8_t r)
+  {
+    Bus::transferOut(header);
+    Bus::transferOut(b);
+    Bus::transferOut(g);
+    Bus::transferOut(r);
+  }
+
+  // Every LED delays the data by half a clock, so the last one needs count / 2
+  // extra clock edges. The first four bytes also latch SK9822 strips
+  static void endFrame(uint16_t count)
+  {
+    for(uint8_t i = 0; i < 4; i++)
+      Bus::transferOut(0x00);
+    for(uint16_t i = count / 16 + 1; i; i--)
+      Bus::transferOut(0xFF);
+  }
+
+  private:
+    uint8_t header = 0xFF;
+};
+
+#endif
@@ -0,0 +1,40 @@
+/*
+  Function generator
+
+  Sine, triangle, sawtooth or square wave from 0 to 1023 Hz.
+  The potentiometer sets the frequency, and the button steps
+  through the waveforms.
+
+  The circuit:
+  * 1k resistor from digital pin 0 (OC0A) to the output, and
+    100nF from the output to GND
+  * Potentiometer wiper on analog pin 2 (PB4), ends to VCC and GND
+  * Pushbutton from digital pin 3 to GND
+*/
+
+#include <TinyDDS.h>
+
+const uint8_t *const waveforms[] = { dds_sine, dds_triangle, dds_sawtooth, dds_square };
+uint8_t waveform;
+
+
+void setup()
+{
+  pinMode(3, INPUT_PULLUP);
+  DDS.begin(dds_sine);
+}
+
+
+void loop()
+{
+  DDS.setFrequency(analogRead(A2));
+
+  if(!digitalRead(3))
+  {
+    waveform = (waveform + 1) & 0x03;
+    DDS.setTable(waveforms[waveform]);
+    while(!digitalRead(3))
+      ;
+    delay(50); // Debounce
+  }
+}
@@ -0,0 +1,142 @@
+/*** MicroCore - TinyDDS.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Direct digital synthesis waveform generator.
+Timer0 runs fast PWM without a prescaler, and a
+sample interrupt in assembly (TinyDDS.S) steps a
+24-bit phase accumulator and loads the next
+sample from a 64 entry wavetable in flash into
+OCR0A, once every 256 clock cycles. The output
+is OC0A (PB0), and needs an RC low pass filter
+(like 1k and 100nF) to become a clean waveform.
+
+The sample rate is F_CPU / 256, and the
+frequency step is the sample rate / 2^24:
+
+| Clock   | Sample rate | Frequency step |
+|---------|-------------|----------------|
+| 20 MHz  | 78.1 kHz    | 0.0047 Hz      |
+| 16 MHz  | 62.5 kHz    | 0.0037 Hz      |
+| 12 MHz  | 46.9 kHz    | 0.0028 Hz      |
+| 9.6 MHz | 37.5 kHz    | 0.0022 Hz      |
+| 8 MHz   | 31.3 kHz    | 0.0019 Hz      |
+| 4.8 MHz | 18.8 kHz    | 0.0011 Hz      |
+| 1.2 MHz | 4.69 kHz    | 0.0003 Hz      |
+
+Every sample interrupt takes 66 cycles, so the
+generator uses 26% of the CPU at every clock.
+Above 1/64 of the sample rate (586 Hz at 9.6 MHz)
+table entries start getting skipped, which is
+fine up to about a quarter of the sample rate.
+
+The waveform is picked by the table given to
+begin(), and only the tables a sketch uses end
+up in flash (64 bytes each). Custom tables work
+the same way:
+  DDS.begin(dds_sine);
+  DDS.setIncrement(DDS_HZ(1000.5));
+
+Timer0 is used for the generator, so
+analogWrite() and tone() are ignored while it
+runs. micros() would add its overflow interrupt
+on top of the 26% above, so enabling it is a
+compile error. delay() is slowed down by the
+sample interrupt, millis() isn't. begin()
+returns false while another library owns
+Timer0, and tone() is ignored until end().
+Servo, TinySoftPWM, TinySynth and TinySample
+also use TIM0_COMPB_vect, so they don't link
+together with TinyDDS.
+*/
+
+#ifndef TinyDDS_h
+#define TinyDDS_h
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+#if defined(ENABLE_MICROS)
+  #error "TinyDDS can't be used together with micros(), disable micros"
+#endif
+
+// Phase increment for a constant frequency in Hz, 2^24 is one cycle per sample
+#define DDS_HZ(hz) ((uint32_t)((hz) * 4294967296.0 / F_CPU + 0.5))
+
+extern "C"
+{
+  // Defined in TinyDDS.S
+  extern volatile __uint24 dds_phase;
+  extern volatile __uint24 dds_increment;
+  extern const uint8_t *volatile dds_table;
+}
+
+// Expands f(0) to f(63)
+#define DDS_TABLE_8(f, n)  f(n), f(n + 1), f(n + 2), f(n + 3), f(n + 4), f(n + 5), f(n + 6), f(n + 7)
+#define DDS_TABLE_64(f)    DDS_TABLE_8(f, 0),  DDS_TABLE_8(f, 8),  DDS_TABLE_8(f, 16), DDS_TABLE_8(f, 24), \
+                           DDS_TABLE_8(f, 32), DDS_TABLE_8(f, 40), DDS_TABLE_8(f, 48), DDS_TABLE_8(f, 56)
+
+#define DDS_TRIANGLE_AT(i) ((i) < 32 ? (i) * 8 + 4 : (63 - (i)) * 8 + 4)
+#define DDS_SAWTOOTH_AT(i) ((i) * 4 + 2)
+#define DDS_SQUARE_AT(i)   ((i) < 32 ? 255 : 0)
+
+static const uint8_t dds_sine[64] PROGMEM =
+{
+  128, 140, 152, 165, 176, 188, 198, 208, 218, 226, 234, 240, 245, 250, 253, 254,
+  255, 254, 253, 250, 245, 240, 234, 226, 218, 208, 198, 188, 176, 165, 152, 140,
+  128, 115, 103,  90,  79,  67,  57,  47,  37,  29,  21,  15,  10,   5,   2,   1,
+    0,   1,   2,   5,  10,  15,  21,  29,  37,  47,  57,  67,  79,  90, 103, 115,
+};
+
+static const uint8_t dds_triangle[64] PROGMEM = { DDS_TABLE_64(DDS_TRIANGLE_AT) };
+static const uint8_t dds_sawtooth[64] PROGMEM = { DDS_TABLE_64(DDS_SAWTOOTH_AT) };
+static const uint8_t dds_square[64] PROGMEM   = { DDS_TABLE_64(DDS_SQUARE_AT) };
+
+struct TinyDDSClass
+{
+  // Take over Timer0 and start generating from a 64 entry PROGMEM table.
+  // Returns false if another library owns Timer0
+  bool begin(const uint8_t *table)
+  {
+    setTable(table);
+    return timer0AudioBegin(pgm_read_byte(table));
+  }
+
+  // Stop the sample interrupt and leave PB0 low
+  void end()
+  {
+    timer0AudioEnd();
+  }
+
+  // Switch waveform without a phase jump
+  void setTable(const uint8_t *table)
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    dds_table = table;
+    SREG = oldSREG;
+  }
+
+  // Raw 24-bit phase increment, see DDS_HZ()
+  void setIncrement(__uint24 increment)
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    dds_increment = increment;
+    SREG = oldSREG;
+  }
+
+  // Whole Hz at runtime. The increment is hz * 2^32 / F_CPU, worked out as an
+  // integer and a 16-bit fractional multiplier, so there's no division
+  void setFrequency(uint16_t hz)
+  {
+    constexpr uint32_t whole = 4294967296.0 / F_CPU;
+    constexpr uint16_t fraction = (4294967296.0 / F_CPU - whole) * 65536.0;
+    setIncrement(hz * whole + (((uint32_t)hz * fraction) >> 16));
+  }
+};
+
+static TinyDDSClass DDS;
+
+#endif
@@ -0,0 +1,45 @@
+/*
+  PCF8574 blink
+
+  Blinks all outputs of a PCF8574 I2C IO expander using
+  the bit-banged TinyI2CMaster library.
+
+  The circuit:
+  * SDA - digital pin 4, with a 4.7k pullup to VCC
+  * SCL - digital pin 3, with a 4.7k pullup to VCC
+  * A0, A1 and A2 of the PCF8574 to GND (address 0x20)
+  * LEDs from VCC through resistors to P0..P7
+
+  The LED on PB2 lights up if the PCF8574 doesn't answer.
+*/
+
+#include <TinyI2CMaster.h>
+
+const uint8_t pcf8574Address = 0x20;
+
+// SDA = PB4, SCL = PB3, fast mode (400 kHz)
+TinyI2CMaster<PB4, PB3> i2c;
+
+
+void setup()
+{
+  pinMode(LED_BUILTIN, OUTPUT);
+  i2c.begin();
+}
+
+
+void loop()
+{
+  pcf8574Write(0x00); // All LEDs on
+  delay(500);
+  pcf8574Write(0xFF); // All LEDs off
+  delay(500);
+}
+
+
+void pcf8574Write(uint8_t value)
+{
+  bool ack = i2c.start(pcf8574Address, I2C_WRITE) && i2c.write(value);
+  i2c.stop();
+  digitalWrite(LED_BUILTIN, !ack);
+}
@@ -0,0 +1,201 @@
+/*** MicroCore - TinyI2CMaster.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Bit-banged I2C master on any two PORTB pins.
+The pins are template parameters, so every pin
+access is a single sbi/cbi/sbis instruction.
+
+The lines are driven open drain by only changing
+DDRB, with PORTB kept low. External pullup
+resistors on SDA and SCL are required. Slaves can
+stretch the clock, and repeated start is supported.
+
+The bit timing is counted in clock cycles at
+compile time from F_CPU. Fast mode (the default)
+gives 400 kHz at 8 MHz and above. At lower clocks
+the delays shrink to zero and the bus simply runs
+as fast as the instructions allow, 15 cycles per
+bit (320 kHz at 4.8 MHz), which is still within
+spec. The whole master is around 200 bytes.
+
+  TinyI2CMaster<PB4, PB3> i2c; // SDA = PB4, SCL = PB3
+  i2c.begin();
+  if(i2c.start(0x20, I2C_WRITE))
+    i2c.write(0x55);
+  i2c.stop();
+
+Pins shared with Serial or PWM (PB0 and PB1)
+need PIN_RELEASED, see FastPin.h.
+*/
+
+#ifndef TinyI2CMaster_h
+#define TinyI2CMaster_h
+
+#include <Arduino.h>
+
+#define I2C_WRITE 0
+#define I2C_READ  1
+
+// Shared by the asm routines below. Burns exactly "cycles" clock cycles
+// (nothing if cycles <= 0) using %[cnt2] as loop counter
+#define TINYI2C_DELAY_MACRO \
+  ".macro i2c_delay cycles            \n" \
+  "  .if (\\cycles) >= 3              \n" \
+  "    ldi  %[cnt2], (\\cycles) / 3   \n" \
+  "  9:                               \n" \
+  "    dec  %[cnt2]                   \n" \
+  "    brne 9b                        \n" \
+  "    .rept (\\cycles) %% 3          \n" \
+  "      nop                          \n" \
+  "    .endr                          \n" \
+  "  .elseif (\\cycles) > 0           \n" \
+  "    .rept (\\cycles)               \n" \
+  "      nop                          \n" \
+  "    .endr                          \n" \
+  "  .endif                           \n" \
+  ".endm                              \n"
+
+template <uint8_t sda, uint8_t scl, bool fast = true, FastPinClaim claim = PIN_DEFAULT>
+struct TinyI2CMaster
+{
+  static_assert(sda != scl, "TinyI2CMaster: SDA and SCL must be different pins");
+
+  // SCL period, and min high/low times in clock cycles (rounded up).
+  // Fast mode: 2.5 us period, 0.6 us high, 1.3 us low
+  // Standard mode: 10 us period, 4.0 us high, 4.7 us low
+  static constexpr uint16_t period  = (F_CPU + (fast ? 399999UL : 99999UL)) / (fast ? 400000UL : 100000UL);
+  static constexpr uint16_t high    = (F_CPU / 10000UL * (fast ? 6 : 40) + 999) / 1000;
+  static constexpr uint16_t lowMin  = (F_CPU / 10000UL * (fast ? 13 : 47) + 999) / 1000;
+  static constexpr uint16_t low     = (period > high + lowMin) ? period - high : lowMin;
+
+  typedef FastPin<sda, claim> SDA;
+  typedef FastPin<scl, claim> SCL;
+
+  // Release both lines
+  static void begin()
+  {
+    SDA::input();
+    SCL::input();
+    SDA::low(); // Open drain, only DDRB is changed from here on
+    SCL::low();
+  }
+
+  // Start condition followed by the address byte. Returns true if a slave acknowledged
+  static bool start(uint8_t address, uint8_t rw)
+  {
+    SDA::output(); // SDA falls while SCL is high
+    __builtin_avr_delay_cycles(high);
+    SCL::output();
+    return write((address << 1) | rw);
+  }
+
+  // Repeated start, without a stop condition in between
+  static bool restart(uint8_t address, uint8_t rw)
+  {
+    SDA::input();
+    __builtin_avr_delay_cycles(low);
+    SCL::input();
+    while(!SCL::read()); // Clock stretching
+    __builtin_avr_delay_cycles(high);
+    return start(address, rw);
+  }
+
+  static void stop()
+  {
+    SDA::output();
+    __builtin_avr_delay_cycles(low);
+    SCL::input();
+    while(!SCL::read()); // Clock stretching
+    __builtin_avr_delay_cycles(high);
+    SDA::input(); // SDA rises while SCL is high
+    __builtin_avr_delay_cycles(low); // Bus free time before the next start
+  }
+
+  // Writes one byte. Returns true if the slave acknowledged
+  static bool write(uint8_t data)
+  {
+    uint8_t cnt, cnt2, ack;
+    asm volatile(
+      TINYI2C_DELAY_MACRO
+      "ldi  %[cnt], 8                     \n"
+      "1:                                 \n"
+      "lsl  %[data]                       \n" // 1  Next bit into carry
+      "brcs 2f                            \n" // 1/2
+      "sbi  %[ddrb], %[sda]               \n" // 2  Pull SDA low for a 0
+      "rjmp 3f                            \n" // 2
+      "2:                                 \n"
+      "cbi  %[ddrb], %[sda]               \n" // 2  Release SDA for a 1
+      "nop                                \n" // 1
+      "3:                                 \n"
+      "i2c_delay (%[low] - 11)            \n"
+      "cbi  %[ddrb], %[scl]               \n" // 2  Release SCL
+      "4:                                 \n"
+      "sbis %[pinb], %[scl]               \n" // 2  Wait while a slave stretches the clock
+      "rjmp 4b                            \n"
+      "i2c_delay (%[high] - 4)            \n"
+      "sbi  %[ddrb], %[scl]               \n" // 2  SCL low
+      "dec  %[cnt]                        \n" // 1
+      "brne 1b                            \n" // 2
+      "cbi  %[ddrb], %[sda]               \n" // 2  Release SDA for the ACK bit
+      "i2c_delay (%[low] - 5)             \n"
+      "cbi  %[ddrb], %[scl]               \n" // 2
+      "5:                                 \n"
+      "sbis %[pinb], %[scl]               \n" // 2
+      "rjmp 5b                            \n"
+      "i2c_delay (%[high] - 5)            \n"
+      "in   %[ack], %[pinb]               \n" // 1  SDA low is ACK
+      "sbi  %[ddrb], %[scl]               \n" // 2
+      ".purgem i2c_delay                  \n"
+      : [data] "+r" (data), [cnt] "=&d" (cnt), [cnt2] "=&d" (cnt2), [ack] "=&r" (ack)
+      : [ddrb] "I" (_SFR_IO_ADDR(DDRB)), [pinb] "I" (_SFR_IO_ADDR(PINB)),
+        [sda] "I" (sda), [scl] "I" (scl), [low] "n" (low), [high] "n" (high)
+    );
+    return !(ack & _BV(sda));
+  }
+
+  // Reads one byte. The byte is acknowledged unless last is true,
+  // which tells the slave that this is the last byte it should send
+  static uint8_t read(bool last = false)
+  {
+    uint8_t data = 0;
+    uint8_t cnt, cnt2;
+    asm volatile(
+      TINYI2C_DELAY_MACRO
+      "cbi  %[ddrb], %[sda]               \n" // Release SDA, the slave drives it
+      "ldi  %[cnt], 8                     \n"
+      "1:                                 \n"
+      "i2c_delay (%[low] - 5)             \n"
+      "cbi  %[ddrb], %[scl]               \n" // 2  Release SCL
+      "2:                                 \n"
+      "sbis %[pinb], %[scl]               \n" // 2  Wait while a slave stretches the clock
+      "rjmp 2b                            \n"
+      "i2c_delay (%[high] - 7)            \n"
+      "lsl  %[data]                       \n" // 1
+      "sbic %[pinb], %[sda]               \n" // 1/2
+      "ori  %[data], 0x01                 \n" // 1
+      "sbi  %[ddrb], %[scl]               \n" // 2  SCL low
+      "dec  %[cnt]                        \n" // 1
+      "brne 1b                            \n" // 2
+      "sbrs %[last], 0                    \n" // ACK by pulling SDA low, NACK by leaving it
+      "sbi  %[ddrb], %[sda]               \n"
+      "i2c_delay (%[low] - 6)             \n"
+      "cbi  %[ddrb], %[scl]               \n" // 2
+      "3:                                 \n"
+      "sbis %[pinb], %[scl]               \n" // 2
+      "rjmp 3b                            \n"
+      "i2c_delay (%[high] - 4)            \n"
+      "sbi  %[ddrb], %[scl]               \n" // 2
+      "cbi  %[ddrb], %[sda]               \n" // Release SDA
+      ".purgem i2c_delay                  \n"
+      : [data] "+d" (data), [cnt] "=&d" (cnt), [cnt2] "=&d" (cnt2)
+      : [ddrb] "I" (_SFR_IO_ADDR(DDRB)), [pinb] "I" (_SFR_IO_ADDR(PINB)),
+        [sda] "I" (sda), [scl] "I" (scl), [low] "n" (low), [high] "n" (high),
+        [last] "r" ((uint8_t)last)
+    );
+    return data;
+  }
+};
+
+#endif
@@ -0,0 +1,44 @@
+/*
+  Register map
+
+  Turns the ATtiny13 into a small I2C IO expander at address 0x42.
+  The master sees four registers:
+  0: LED on PB2 (write 0 or 1)
+  1: Button on PB3 (read, 1 = pressed)
+  2: Time since power up in 1.024 s steps (read)
+  3: Scratch byte (read and write)
+
+  Reading register 1 from an Arduino master:
+    Wire.beginTransmission(0x42);
+    Wire.write(1);
+    Wire.endTransmission(false);
+    Wire.requestFrom(0x42, 1);
+
+  The circuit:
+  * SDA - digital pin 0, with a 4.7k pullup to VCC
+  * SCL - digital pin 1, with a 4.7k pullup to VCC
+  * LED on digital pin 2
+  * Pushbutton from digital pin 3 to GND
+*/
+
+#include <TinyI2CSlave.h>
+
+volatile uint8_t regs[4];
+
+
+void setup()
+{
+  pinMode(LED_BUILTIN, OUTPUT);
+  pinMode(3, INPUT_PULLUP);
+  TinyI2CSlave.begin(0x42, regs, sizeof(regs), PB0, PB1);
+}
+
+
+void loop()
+{
+  if(TinyI2CSlave.changed())
+    digitalWrite(LED_BUILTIN, regs[0]);
+
+  regs[1] = !digitalRead(3);
+  regs[2] = millis() >> 10; // Cheaper than dividing by 1000
+}
@@ -0,0 +1,90 @@
+/*** MicroCore - TinyI2CSlave.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Bit-banged I2C slave on any two PORTB pins.
+The master sees a register map: a byte array in
+the sketch that it can read and write through a
+register pointer, the same way as most I2C
+sensors and IO expanders work.
+
+The bus is handled by the pin change interrupt
+in TinyI2CSlave.S. It answers standard mode
+(100 kHz) masters at 9.6 MHz and above. At lower
+clocks the master has to run the bus slower.
+millis() keeps running, see TinyI2CSlave.S for
+how the ISR shares the CPU with WDT_vect. A
+START that comes while WDT_vect runs can be
+missed, and the master then gets a NACK, so it
+should retry a transfer that isn't ACKed.
+
+The pin change interrupt can't be used for
+anything else (like RotaryEncoder) while the
+slave is running.
+*/
+
+#ifndef TinyI2CSlave_h
+#define TinyI2CSlave_h
+
+#include <Arduino.h>
+
+extern "C"
+{
+  // Defined in TinyI2CSlave.S
+  extern uint8_t i2cs_address;
+  extern uint8_t i2cs_sda;
+  extern uint8_t i2cs_scl;
+  extern uint8_t i2cs_regs;
+  extern uint8_t i2cs_size;
+  extern volatile uint8_t i2cs_index;
+  extern volatile uint8_t i2cs_changed;
+}
+
+struct TinyI2CSlaveClass
+{
+  // Answer to the 7-bit address with the size byte register map in regs.
+  // SDA and SCL need external pullups
+  void begin(uint8_t address, volatile uint8_t *regs, uint8_t size, uint8_t sdaPin, uint8_t sclPin)
+  {
+    const uint8_t sdaMask = _BV(sdaPin);
+    const uint8_t sclMask = _BV(sclPin);
+
+    cli();
+    DDRB &= ~(sdaMask | sclMask); // Open drain: released lines are inputs,
+    PORTB &= ~(sdaMask | sclMask); // and driven lines are outputs pulled low
+    i2cs_address = address << 1;
+    i2cs_sda = sdaMask;
+    i2cs_scl = sclMask;
+    i2cs_regs = (uint8_t)(uint16_t)regs;
+    i2cs_size = size;
+    i2cs_index = 0;
+    i2cs_changed = 0;
+    PCMSK |= sdaMask;
+    GIFR = _BV(PCIF);
+    GIMSK |= _BV(PCIE);
+    sei(); // The slave needs interrupts, so don't restore SREG
+  }
+
+  // Stop answering. Must not be called from inside a transfer
+  void end()
+  {
+    PCMSK &= ~i2cs_sda;
+    GIMSK &= ~_BV(PCIE);
+  }
+
+  // True if the master has written a register since the last call
+  bool changed()
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    uint8_t c = i2cs_changed;
+    i2cs_changed = 0;
+    SREG = oldSREG;
+    return c;
+  }
+};
+
+static TinyI2CSlaveClass TinyI2CSlave;
+
+#endif
@@ -0,0 +1,44 @@
+/*
+  IR relay
+
+  Toggles a relay (or LED) with any button on an NEC or RC5
+  remote control. Holding the button down doesn't toggle it
+  again: NEC repeat codes are ignored, and so are RC5 frames
+  with the same toggle bit as the last one.
+
+  The circuit:
+  * IR receiver module (TSOP38238 or similar) output to digital pin 1
+  * Relay driver or LED on digital pin 2
+*/
+
+#include <TinyIRReceiver.h>
+
+uint8_t lastToggle = 0xFF;
+
+
+void setup()
+{
+  pinMode(LED_BUILTIN, OUTPUT);
+  IRReceiver.begin();
+}
+
+
+void loop()
+{
+  IRCommand cmd;
+  if(IRReceiver.read(cmd))
+  {
+    if(cmd.flags & IR_REPEAT)
+      return;
+    if(cmd.flags & IR_PROTOCOL_RC5)
+    {
+      uint8_t toggle = cmd.flags & IR_TOGGLE;
+      if(toggle == lastToggle)
+        return;
+      lastToggle = toggle;
+    }
+    PINB = _BV(LED_BUILTIN); // Toggle the relay
+  }
+
+  // Other work can be done here, the receiver decodes in the background
+}
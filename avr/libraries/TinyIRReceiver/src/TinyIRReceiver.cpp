@@ -0,0 +1,205 @@
+/*** MicroCore - TinyIRReceiver.cpp ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+INT0 state machine for the TinyIRReceiver
+library. The receiver output is low while
+a carrier burst (mark) is received, so the
+pin level right after an edge tells whether
+the interval that just ended was a mark or
+a space (pause).
+
+NEC: 9 ms mark, 4.5 ms space, then 32 bits
+LSB first (address, ~address, command,
+~command). A bit is a 562 us mark followed by
+a 562 us (0) or 1687 us (1) space. A 2.25 ms
+space after the 9 ms mark is a repeat code.
+
+RC5: 14 Manchester coded bits of 1778 us, sent
+MSB first: two start bits, toggle, 5 address
+and 6 command bits. A 1 is a space followed by
+a mark. Marks and spaces are either one or two
+half bits long, and every half bit that ends a
+bit gives the value of that bit.
+
+Both protocols are shifted through 16 bits, so
+the NEC address is put aside after the first
+half of the frame. A repeat code reuses the
+address and command of the last NEC entry in the
+queue, which stays there after it's read.
+*/
+
+#include "TinyIRReceiver.h"
+#include <avr/interrupt.h>
+
+// Timer0 ticks for a time in microseconds, with the core's default prescaler
+#if F_CPU >= 4800000L
+  #define IR_PRESCALER 64
+#else
+  #define IR_PRESCALER 8
+#endif
+#define IR_TICKS(us) ((uint16_t)((F_CPU / 1000UL * (us)) / (IR_PRESCALER * 1000UL)))
+
+// States in bits 6..7 of ir_state
+#define IR_IDLE       0x00
+#define IR_NEC_LEADER 0x40
+#define IR_NEC_DATA   0x80
+#define IR_RC5        0xC0
+#define IR_COUNT_MASK 0x3F
+
+volatile IRCommand ir_queue[IR_QUEUE_SIZE];
+volatile uint8_t ir_head;
+volatile uint8_t ir_tail;
+
+static uint16_t ir_last;      // Timestamp of the last edge
+static uint8_t ir_state;      // State, and NEC bits or RC5 half bits received in bits 0..5
+static uint16_t ir_data;
+static uint8_t ir_necAddress; // First half of the NEC frame that comes in
+
+// High byte of the timestamp
+#if defined(ENABLE_MICROS)
+  extern volatile uint32_t timer0_overflow; // Defined in wiring.c
+  #define IR_OVERFLOW ((uint8_t)timer0_overflow)
+#else
+  static volatile uint8_t ir_overflow;
+  #define IR_OVERFLOW ir_overflow
+
+  ISR(TIM0_OVF_vect)
+  {
+    ir_overflow++;
+  }
+#endif
+
+
+static inline bool inRange(uint16_t t, uint16_t min, uint16_t max)
+{
+  return t >= min && t <= max;
+}
+
+
+// Drop the command if the queue is full
+static void push(uint8_t flags, uint8_t address, uint8_t command)
+{
+  if((uint8_t)(ir_head - ir_tail) >= IR_QUEUE_SIZE)
+    return;
+  const uint8_t i = ir_head & (IR_QUEUE_SIZE - 1);
+  ir_queue[i].flags = flags;
+  ir_queue[i].address = address;
+  ir_queue[i].command = command;
+  ir_head++;
+}
+
+
+// Takes the half bits received so far, returns the next state and count
+static uint8_t rc5(uint8_t count, uint8_t endedMark, uint16_t delta)
+{
+  uint8_t halves;
+  if(inRange(delta, IR_TICKS(889 * 7 / 10), IR_TICKS(889 * 13 / 10)))
+    halves = 1;
+  else if(inRange(delta, IR_TICKS(1778 * 7 / 10), IR_TICKS(1778 * 13 / 10)) && (count & 0x01))
+    halves = 2; // Only valid across a bit boundary
+  else
+    return IR_IDLE;
+
+  do
+  {
+    if(count & 0x01) // Second half of a bit
+      ir_data = (ir_data << 1) | endedMark;
+    count++;
+  }
+  while(--halves);
+
+  // A 0 as the last bit ends with a space, which has no edge after it
+  if(count == 27 && endedMark)
+  {
+    ir_data <<= 1;
+    count = 28;
+  }
+
+  if(count < 28)
+    return IR_RC5 | count;
+
+  const uint16_t frame = ir_data;
+  uint8_t command = frame & 0x3F;
+  if(!(frame & 0x1000)) // Second start bit is the inverted 7th command bit in RC5X
+    command |= 0x40;
+  push(IR_PROTOCOL_RC5 | ((frame & 0x0800) ? IR_TOGGLE : 0), (frame >> 6) & 0x1F, command);
+  return IR_IDLE;
+}
+
+
+ISR(INT0_vect)
+{
+  // 16-bit timestamp. An overflow that happened after this ISR started
+  // hasn't been counted yet, so count it here if TCNT0 has just wrapped
+  const uint8_t lo = TCNT0;
+  uint8_t hi = IR_OVERFLOW;
+  if((TIFR0 & _BV(TOV0)) && lo < 128)
+    hi++;
+  const uint16_t now = (hi << 8) | lo;
+  const uint16_t delta = now - ir_last;
+  ir_last = now;
+
+  const uint8_t endedMark = (PINB & _BV(PB1)) ? 1 : 0;
+  uint8_t state = ir_state & ~IR_COUNT_MASK;
+  uint8_t count = ir_state & IR_COUNT_MASK;
+
+  if(delta > IR_TICKS(12000)) // Nothing for a while, so this is a new frame
+    state = IR_IDLE;
+
+  switch(state)
+  {
+    case IR_IDLE:
+      if(endedMark)
+      {
+        if(inRange(delta, IR_TICKS(7000), IR_TICKS(11000)))
+          state = IR_NEC_LEADER;
+        else
+          state = rc5(1, endedMark, delta); // RC5 starts in the middle of the first start bit
+      }
+      ir_state = state;
+      return;
+
+    case IR_NEC_LEADER:
+      state = IR_IDLE;
+      count = 0;
+      if(inRange(delta, IR_TICKS(3500), IR_TICKS(5500)))
+        state = IR_NEC_DATA;
+      else if(inRange(delta, IR_TICKS(1800), IR_TICKS(2800)))
+      {
+        const uint8_t i = (ir_head - 1) & (IR_QUEUE_SIZE - 1);
+        if(ir_queue[i].flags & IR_PROTOCOL_NEC)
+          push(IR_PROTOCOL_NEC | IR_REPEAT, ir_queue[i].address, ir_queue[i].command);
+      }
+      break;
+
+    case IR_NEC_DATA:
+      if(endedMark) // Marks are all the same length
+        break;
+      if(!inRange(delta, IR_TICKS(300), IR_TICKS(2200)))
+      {
+        state = IR_IDLE;
+        break;
+      }
+      ir_data >>= 1;
+      if(delta > IR_TICKS(1125))
+        ir_data |= 0x8000;
+      if(++count == 16)
+        ir_necAddress = ir_data; // Address and inverted (or extended) address
+      else if(count == 32)
+      {
+        const uint8_t command = ir_data;
+        if(command == (uint8_t)~(ir_data >> 8))
+          push(IR_PROTOCOL_NEC, ir_necAddress, command);
+        state = IR_IDLE;
+        count = 0;
+      }
+      break;
+
+    case IR_RC5:
+      ir_state = rc5(count, endedMark, delta);
+      return;
+  }
+  ir_state = state | count;
+}
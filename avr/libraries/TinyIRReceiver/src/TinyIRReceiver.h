@@ -0,0 +1,134 @@
+/*** MicroCore - TinyIRReceiver.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+NEC and RC5 infrared remote receiver for a
+TSOP-style receiver module on PB1 (INT0).
+
+Every edge on PB1 is timestamped with Timer0
+ticks, and a small state machine in the INT0
+interrupt decodes the frame as it comes in.
+Decoded commands are put in a queue of two,
+so loop() never waits for a frame and just
+reads the queue when it has time. A key that is
+held down repeats every 108 ms, so a loop()
+slower than 200 ms drops some of them. All
+state, including the queue, takes 15 bytes of
+RAM (14 with micros() enabled).
+
+Timer0 has to run with the prescaler the core
+uses for analogWrite() and micros(): F_CPU/64
+from 4.8 MHz and up, F_CPU/8 below, and overflow
+every 256 ticks. begin() claims Timer0 and sets
+that up, which drops an analogWriteFrequency()
+or phase correct analogWriteMode() setting.
+analogWrite() and micros() can be used together
+with the receiver. tone(), analogWriteFrequency(),
+analogWriteMode() and the other Timer0 libraries
+are ignored until end(), and begin() returns
+false while one of them owns Timer0.
+The receiver shares the overflow count of
+micros() when it's enabled, and otherwise counts
+Timer0 overflows in its own TIM0_OVF_vect. Both
+follow ENABLE_MICROS from core_settings.h or the
+Tools menu, so there's only ever one of them.
+
+attachInterrupt() can't be used together with
+the receiver, since both need INT0.
+*/
+
+#ifndef TinyIRReceiver_h
+#define TinyIRReceiver_h
+
+#include <Arduino.h>
+
+#define IR_QUEUE_SIZE 2 // Power of two
+
+// Shared with TinyIRSender
+#ifndef TINYIR_COMMAND
+#define TINYIR_COMMAND
+
+// IRCommand flags
+#define IR_PROTOCOL_NEC 0x01
+#define IR_PROTOCOL_RC5 0x02
+#define IR_REPEAT       0x40 // NEC repeat code, address and command are from the last frame
+#define IR_TOGGLE       0x80 // RC5 toggle bit, flips on every new key press
+
+struct IRCommand
+{
+  uint8_t flags;
+  uint8_t address; // NEC: 8-bit address, RC5: 5-bit system
+  uint8_t command; // NEC: 8-bit command, RC5: 6-bit command (7-bit for RC5X)
+};
+
+#endif
+
+extern "C"
+{
+  // Defined in TinyIRReceiver.cpp
+  extern volatile IRCommand ir_queue[IR_QUEUE_SIZE];
+  extern volatile uint8_t ir_head;
+  extern volatile uint8_t ir_tail;
+}
+
+struct TinyIRReceiverClass
+{
+  // Start decoding on PB1. Returns false if another library owns Timer0
+  bool begin()
+  {
+    if(!timer0Claim(TIMER0_IRRECV))
+      return false;
+    DDRB &= ~_BV(PB1); // Receiver modules have an open collector output with pullup
+    cli();
+    #if !defined(ENABLE_MICROS)
+      TIMSK0 |= _BV(TOIE0);
+    #endif
+    if((TCCR0A & (_BV(WGM01) | _BV(WGM00))) == _BV(WGM00))
+      TCCR0A |= _BV(WGM01); // Phase correct PWM overflows every 510 ticks, use fast PWM
+    #if F_CPU >= 4800000L
+      TCCR0B = _BV(CS00) | _BV(CS01); // F_CPU/64
+    #else
+      TCCR0B = _BV(CS01);             // F_CPU/8
+    #endif
+    MCUCR = (MCUCR & ~(_BV(ISC01) | _BV(ISC00))) | _BV(ISC00); // Any edge
+    GIFR = _BV(INTF0);
+    GIMSK |= _BV(INT0);
+    sei(); // The receiver needs interrupts, so don't restore SREG
+    return true;
+  }
+
+  void end()
+  {
+    if(timer0_owner != TIMER0_IRRECV)
+      return;
+    GIMSK &= ~_BV(INT0);
+    #if !defined(ENABLE_MICROS)
+      TIMSK0 &= ~_BV(TOIE0);
+    #endif
+    timer0Release(TIMER0_IRRECV);
+  }
+
+  // Number of commands waiting in the queue
+  uint8_t available()
+  {
+    return ir_head - ir_tail;
+  }
+
+  // Takes the oldest command from the queue. Returns false if it's empty
+  bool read(IRCommand &cmd)
+  {
+    if(ir_head == ir_tail)
+      return false;
+    const uint8_t i = ir_tail & (IR_QUEUE_SIZE - 1);
+    cmd.flags = ir_queue[i].flags;
+    cmd.address = ir_queue[i].address;
+    cmd.command = ir_queue[i].command;
+    ir_tail++; // The ISR only writes ir_head, so this is safe without cli()
+    return true;
+  }
+};
+
+static TinyIRReceiverClass IRReceiver;
+
+#endif
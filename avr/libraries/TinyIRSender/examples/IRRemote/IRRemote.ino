@@ -0,0 +1,59 @@
+/*
+  IR remote
+
+  A two button remote control. The button on PB3 sends the
+  first code in the table, the button on PB4 the second one.
+  While the NEC button is held down, NEC repeat codes are sent.
+
+  The circuit:
+  * IR LED driven by an NPN transistor from digital pin 0 (OC0A)
+  * Pushbuttons from digital pins 3 and 4 to GND
+*/
+
+#include <TinyIRSender.h>
+
+const IRCommand codes[] PROGMEM =
+{
+  { IR_PROTOCOL_NEC, 0x00, 0x45 }, // NEC address 0x00, command 0x45
+  { IR_PROTOCOL_RC5, 0x00, 0x0C }, // RC5 TV, standby
+};
+
+TinyIRSender<PB0> ir;
+bool rc5Toggle;
+
+
+void setup()
+{
+  pinMode(3, INPUT_PULLUP);
+  pinMode(4, INPUT_PULLUP);
+  ir.begin();
+}
+
+
+void loop()
+{
+  if(!digitalRead(3))
+  {
+    ir.send_P(codes, 0);
+    delay(40); // Frame is 68 ms, repeats start 108 ms after the frame started
+    while(!digitalRead(3))
+    {
+      ir.sendNECRepeat();
+      delay(97);
+    }
+  }
+
+  if(!digitalRead(4))
+  {
+    // RC5 remotes flip the toggle bit on every new key press
+    IRCommand cmd;
+    memcpy_P(&cmd, &codes[1], sizeof(cmd));
+    if(rc5Toggle)
+      cmd.flags |= IR_TOGGLE;
+    rc5Toggle = !rc5Toggle;
+    ir.send(cmd);
+    while(!digitalRead(4))
+      ;
+    delay(50); // Debounce
+  }
+}
@@ -0,0 +1,233 @@
+/*** MicroCore - TinyIRSender.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+NEC and RC5 infrared remote transmitter. The
+38 kHz carrier is made by Timer0 in CTC mode,
+toggling OC0A (PB0) or OC0B (PB1) in hardware,
+so it's exact at any clock and costs no CPU
+time. The CPU only connects and disconnects the
+carrier for the mark and space durations.
+
+| Clock   | Prescaler | OCR0A | Carrier  |
+|---------|-----------|-------|----------|
+| 20 MHz  | 8         | 32    | 37.9 kHz |
+| 16 MHz  | 1         | 210   | 37.9 kHz |
+| 12 MHz  | 1         | 157   | 38.0 kHz |
+| 9.6 MHz | 1         | 125   | 38.1 kHz |
+| 8 MHz   | 1         | 104   | 38.1 kHz |
+| 4.8 MHz | 1         | 62    | 38.1 kHz |
+| 1.2 MHz | 1         | 15    | 37.5 kHz |
+| 1 MHz   | 1         | 12    | 38.5 kHz |
+| 600 kHz | 1         | 7     | 37.5 kHz |
+
+128 kHz is too slow, the carrier would end up at
+32 kHz, so it's a compile error.
+
+Timer0 is set up for the carrier only while a
+frame is sent, and its registers (including the
+PWM settings) are restored afterwards.
+Timer0 interrupts are off during a frame, and
+micros() loses the time the frame takes. A send
+function returns false and sends nothing while
+a tone plays or another library owns Timer0.
+
+Commands can be sent directly, or from a table
+of IRCommand entries in PROGMEM:
+  const IRCommand codes[] PROGMEM = {
+    { IR_PROTOCOL_NEC, 0x00, 0x45 },
+    { IR_PROTOCOL_RC5, 0x00, 0x0C },
+  };
+  TinyIRSender<PB0> ir;
+  ir.send_P(codes, 1);
+
+Use an IR LED with a transistor driver, the
+pin can't drive a useful LED current by itself.
+*/
+
+#ifndef TinyIRSender_h
+#define TinyIRSender_h
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+// Shared with TinyIRReceiver
+#ifndef TINYIR_COMMAND
+#define TINYIR_COMMAND
+
+// IRCommand flags
+#define IR_PROTOCOL_NEC 0x01
+#define IR_PROTOCOL_RC5 0x02
+#define IR_REPEAT       0x40 // NEC repeat code, address and command are from the last frame
+#define IR_TOGGLE       0x80 // RC5 toggle bit, flips on every new key press
+
+struct IRCommand
+{
+  uint8_t flags;
+  uint8_t address; // NEC: 8-bit address, RC5: 5-bit system
+  uint8_t command; // NEC: 8-bit command, RC5: 6-bit command (7-bit for RC5X)
+};
+
+#endif
+
+template <uint8_t pin>
+struct TinyIRSender
+{
+  static_assert(pin == PB0 || pin == PB1, "TinyIRSender: the carrier is only available on OC0A (PB0) and OC0B (PB1)");
+  static_assert(F_CPU >= 600000UL, "TinyIRSender: the 38 kHz carrier needs F_CPU of 600 kHz or more");
+
+  // Two compare matches per carrier period, rounded to the nearest OCR0A value
+  static constexpr uint16_t prescaler = (F_CPU / 76000UL > 256) ? 8 : 1;
+  static constexpr uint8_t top = (F_CPU / prescaler + 38000UL) / 76000UL - 1;
+  static constexpr uint8_t comBit = (pin == PB0) ? _BV(COM0A0) : _BV(COM0B0);
+
+  static void begin()
+  {
+    PORTB &= ~_BV(pin); // The pin is low while the carrier is disconnected
+    DDRB |= _BV(pin);
+  }
+
+  static bool sendNEC(uint8_t address, uint8_t command)
+  {
+    if(!timer0Claim(TIMER0_IRSEND))
+      return false;
+    const Timer0State saved = start();
+    mark<562>(16); // 9 ms leader
+    space<562>(8);
+    necByte(address);
+    necByte(~address);
+    necByte(command);
+    necByte(~command);
+    mark<562>(1);
+    stop(saved);
+    return true;
+  }
+
+  // Sent every 108 ms while a key is held down, after the first frame
+  static bool sendNECRepeat()
+  {
+    if(!timer0Claim(TIMER0_IRSEND))
+      return false;
+    const Timer0State saved = start();
+    mark<562>(16);
+    space<562>(4);
+    mark<562>(1);
+    stop(saved);
+    return true;
+  }
+
+  // 7-bit commands use the RC5X extension, where the second start bit is the inverted bit 6
+  static bool sendRC5(uint8_t address, uint8_t command, bool toggle)
+  {
+    if(!timer0Claim(TIMER0_IRSEND))
+      return false;
+    uint16_t frame = 0x2000 | ((address & 0x1F) << 6) | (command & 0x3F);
+    if(!(command & 0x40))
+      frame |= 0x1000;
+    if(toggle)
+      frame |= 0x0800;
+
+    // Manchester code: a 1 is a space followed by a mark, a 0 the other way around
+    const Timer0State saved = start();
+    for(uint16_t mask = 0x2000; mask; mask >>= 1)
+    {
+      if(frame & mask)
+      {
+        space<889>(1);
+        mark<889>(1);
+      }
+      else
+      {
+        mark<889>(1);
+        space<889>(1);
+      }
+    }
+    stop(saved);
+    return true;
+  }
+
+  static bool send(const IRCommand &cmd)
+  {
+    if(cmd.flags & IR_PROTOCOL_RC5)
+      return sendRC5(cmd.address, cmd.command, cmd.flags & IR_TOGGLE);
+    else if(cmd.flags & IR_REPEAT)
+      return sendNECRepeat();
+    else
+      return sendNEC(cmd.address, cmd.command);
+  }
+
+  // Send entry number index of a PROGMEM table
+  static bool send_P(const IRCommand *table, uint8_t index)
+  {
+    IRCommand cmd;
+    memcpy_P(&cmd, &table[index], sizeof(cmd));
+    return send(cmd);
+  }
+
+  private:
+  // Carrier on and off for a number of time units
+  template <uint16_t us>
+  static void mark(uint8_t units)
+  {
+    TCCR0A |= comBit;
+    do
+      _delay_us(us);
+    while(--units);
+  }
+
+  template <uint16_t us>
+  static void space(uint8_t units)
+  {
+    TCCR0A &= ~comBit;
+    do
+      _delay_us(us);
+    while(--units);
+  }
+
+  // LSB first. Every bit is a 562 us mark followed by a 562 us (0) or 1687 us (1) space
+  static void necByte(uint8_t data)
+  {
+    for(uint8_t i = 0; i < 8; i++)
+    {
+      mark<562>(1);
+      space<562>((data & 0x01) ? 3 : 1);
+      data >>= 1;
+    }
+  }
+
+  // Timer0 settings to restore after the frame
+  struct Timer0State
+  {
+    uint8_t tccr0a, tccr0b, ocr0a, ocr0b, timsk0;
+  };
+
+  static Timer0State start()
+  {
+    const Timer0State saved = { TCCR0A, TCCR0B, OCR0A, OCR0B, TIMSK0 };
+    TIMSK0 = 0;
+    TCCR0B = 0;
+    TCCR0A = _BV(WGM01); // CTC, carrier disconnected
+    OCR0A = top;
+    OCR0B = 0;
+    TCNT0 = 0;
+    TCCR0B = (prescaler == 8) ? _BV(CS01) : _BV(CS00);
+    return saved;
+  }
+
+  static void stop(const Timer0State &saved)
+  {
+    TCCR0A &= ~comBit;
+    TCCR0B = 0;
+    OCR0A = saved.ocr0a;
+    OCR0B = saved.ocr0b;
+    TCCR0A = saved.tccr0a;
+    TCNT0 = 0;
+    TIFR0 = _BV(OCF0A) | _BV(OCF0B) | _BV(TOV0);
+    TIMSK0 = saved.timsk0;
+    TCCR0B = saved.tccr0b;
+    timer0Release(TIMER0_IRSEND);
+  }
+};
+
+#endif
@@ -0,0 +1,49 @@
+/*
+  Jingle
+
+  Plays a short tune in the background every time the
+  button is pressed, while the LED keeps blinking. Hold the
+  button down to play it in a loop, it stops at the end of
+  the round after the button is released.
+
+  The circuit:
+  * Piezo buzzer from digital pin 0 (OC0A) to GND
+  * Pushbutton from digital pin 3 to GND
+  * LED on digital pin 2 (LED_BUILTIN)
+*/
+
+#include <TinyMelody.h>
+
+// Notes are MIDI numbers (60 = middle C), lengths are ~19 ms ticks
+const MelodyNote jingle[] PROGMEM =
+{
+  { 72, 6 }, { 76, 6 }, { 79, 6 }, { 84, 12 },
+  { MELODY_REST, 4 },
+  { 79, 6 }, { MELODY_REST, 1 }, { 79, 6 }, { 84, 20 },
+  { MELODY_REST, 10 },
+};
+
+uint32_t lastBlink;
+
+
+void setup()
+{
+  pinMode(3, INPUT_PULLUP);
+  pinMode(LED_BUILTIN, OUTPUT);
+}
+
+
+void loop()
+{
+  const bool pressed = !digitalRead(3);
+  if(pressed && !Melody.isPlaying())
+    Melody.play(PB0, jingle, sizeof(jingle) / sizeof(jingle[0]), true);
+  Melody.loop(pressed);
+
+  // The sketch keeps running while the melody plays
+  if(millis() - lastBlink >= 250)
+  {
+    lastBlink = millis();
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+  }
+}
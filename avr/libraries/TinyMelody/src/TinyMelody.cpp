@@ -0,0 +1,53 @@
+/*** MicroCore - TinyMelody.cpp ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Melody state and the note step, called from
+the watchdog interrupt through tone_end_hook
+(TinyMelody.S) and from play().
+*/
+
+#include "TinyMelody.h"
+
+const MelodyNote *melody_start;
+const MelodyNote *melody_next_note;
+uint8_t melody_length;
+uint8_t melody_left;
+uint8_t melody_pin;
+volatile bool melody_loop;
+volatile bool melody_playing;
+
+
+// Interrupts have to be off
+extern "C" void melody_next()
+{
+  if(!melody_playing)
+    return;
+
+  if(melody_left == 0)
+  {
+    if(!melody_loop)
+    {
+      // Timer0 goes back to what it was before the melody
+      melody_playing = false;
+      tone_hold = 0;
+      stopTone();
+      return;
+    }
+    melody_next_note = melody_start;
+    melody_left = melody_length;
+  }
+
+  const uint8_t note = pgm_read_byte(&melody_next_note->note);
+  uint8_t ticks = pgm_read_byte(&melody_next_note->ticks);
+  melody_next_note++;
+  melody_left--;
+
+  if(ticks == 0) // 0 would play forever
+    ticks = 1;
+  if((uint8_t)(note - MIDI_NOTE_LOWEST) <= MIDI_NOTE_HIGHEST - MIDI_NOTE_LOWEST)
+    toneNote(melody_pin, note, ticks);
+  else
+    toneRest(melody_pin, ticks);
+}
@@ -0,0 +1,126 @@
+/*** MicroCore - TinyMelody.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Plays a melody from PROGMEM in the background.
+Every note is a toneNote() on PB0 or PB1, so the
+waveform is toggled by Timer0 in hardware, and
+the next note is started from the millis()
+watchdog tick when the previous one is over.
+The sketch keeps running while the melody plays,
+and the CPU is only busy once per note.
+
+A melody is an array of { note, ticks } pairs:
+  - note is a MIDI note from MIDI_NOTE_LOWEST (48,
+    C3) to MIDI_NOTE_HIGHEST (84, C6), 60 is
+    middle C. Anything else, like MELODY_REST, is
+    a rest
+  - ticks is the length in watchdog ticks of about
+    19 ms (TONE_TICK_MS), from 1 to 255
+
+  const MelodyNote jingle[] PROGMEM =
+  {
+    { 72, 8 }, { 76, 8 }, { 79, 8 }, { 84, 16 },
+  };
+  Melody.play(PB0, jingle, 4);
+
+Two notes of the same pitch right after each
+other sound like one long note, put a short rest
+between them to hear both.
+
+Timer0 is used for the notes, so analogWrite(),
+tone() and micros() can't be used while a melody
+plays. Timer0 gets its setup from before the
+melody back when the melody ends or is stopped,
+not between notes. play() returns false while
+another library owns Timer0. Needs
+TONE_HW_TOGGLE in core_settings.h.
+*/
+
+#ifndef TinyMelody_h
+#define TinyMelody_h
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+#ifndef TONE_HW_TOGGLE
+  #error "TinyMelody needs TONE_HW_TOGGLE in core_settings.h"
+#endif
+
+#define MELODY_REST 0
+
+struct MelodyNote
+{
+  uint8_t note;
+  uint8_t ticks;
+};
+
+extern "C"
+{
+  // Defined in TinyMelody.cpp
+  extern const MelodyNote *melody_start;
+  extern const MelodyNote *melody_next_note;
+  extern uint8_t melody_length;
+  extern uint8_t melody_left;
+  extern uint8_t melody_pin;
+  extern volatile bool melody_loop;
+  extern volatile bool melody_playing;
+  void melody_next();
+
+  // Defined in Tone.cpp
+  extern volatile uint8_t tone_hold;
+}
+
+struct TinyMelodyClass
+{
+  // Start playing length notes from melody on PB0 or PB1, and start
+  // over from the first note when the last one is over if loop is true.
+  // Returns false for an empty melody, or if another library owns Timer0
+  bool play(uint8_t pin, const MelodyNote *melody, uint8_t length, bool loop = false)
+  {
+    if(length == 0)
+      return false;
+    if(!timer0Claim(TIMER0_TONE))
+      return false;
+    noTone(pin);
+    timer0Claim(TIMER0_TONE); // noTone() gave it back
+    cli();
+    melody_start = melody;
+    melody_next_note = melody;
+    melody_length = length;
+    melody_left = length;
+    melody_pin = pin;
+    melody_loop = loop;
+    melody_playing = true;
+    tone_hold = 1; // Timer0 stays set up for notes until the melody is over
+    melody_next();
+    sei(); // The melody needs the watchdog interrupt, so don't restore SREG
+    return true;
+  }
+
+  // Stop right away. Does nothing if no melody plays, so a tone() isn't cut off
+  void stop()
+  {
+    if(!melody_playing)
+      return;
+    melody_playing = false;
+    tone_hold = 0;
+    noTone(melody_pin);
+  }
+
+  // Let the current round finish, and stop after the last note
+  void loop(bool enable)
+  {
+    melody_loop = enable;
+  }
+
+  bool isPlaying()
+  {
+    return melody_playing;
+  }
+};
+
+static TinyMelodyClass Melody;
+
+#endif
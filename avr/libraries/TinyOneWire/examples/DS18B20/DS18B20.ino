@@ -0,0 +1,62 @@
+/*
+  DS18B20 thermometer
+
+  Reads the temperature from a single DS18B20 sensor every
+  second and prints it to the serial monitor in degrees C.
+
+  The circuit:
+  * DS18B20 data pin to digital pin 4, with a 4.7k pullup to VCC
+  * DS18B20 GND to GND and VDD to VCC
+  * Serial TX on digital pin 0 (see the MicroCore readme)
+*/
+
+#include <TinyOneWire.h>
+
+TinyOneWire<PB4> ow;
+
+
+void setup()
+{
+  Serial.begin();
+  ow.begin();
+}
+
+
+void loop()
+{
+  uint8_t scratchpad[9];
+
+  if(!ow.reset())
+  {
+    Serial.println(F("No sensor"));
+    delay(1000);
+    return;
+  }
+  ow.skip();
+  ow.write(0x44); // Convert T
+  delay(750);     // 12-bit conversion time
+
+  ow.reset();
+  ow.skip();
+  ow.write(0xBE); // Read scratchpad
+  for(uint8_t i = 0; i < 9; i++)
+    scratchpad[i] = ow.read();
+
+  if(ow.crc8(scratchpad, 9) != 0)
+  {
+    Serial.println(F("CRC error"));
+    return;
+  }
+
+  // Temperature is in 1/16 degrees
+  int16_t raw = scratchpad[0] | (scratchpad[1] << 8);
+  if(raw < 0)
+  {
+    Serial.write('-');
+    raw = -raw;
+  }
+  Serial.print(raw >> 4);
+  Serial.write('.');
+  Serial.println(((raw & 0x0F) * 10) >> 4);
+  delay(250);
+}
@@ -0,0 +1,254 @@
+/*** MicroCore - TinyOneWire.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Dallas/Maxim 1-Wire master on any PORTB pin.
+The pin is a template parameter, so every pin
+access is a single sbi/cbi/in instruction.
+
+The bus is driven open drain by only changing
+DDRB, with PORTB kept low. An external 4.7k
+pullup resistor on the data line is required.
+
+Every time slot is a single asm block with its
+delays counted in clock cycles at compile time
+from F_CPU. Interrupts are only off inside a
+slot (about 60 us) and in the 70 us between the
+end of a reset pulse and the presence sample.
+The recovery time between slots and the reset
+pulse itself run with interrupts on, so the
+millis() watchdog tick is never lost.
+
+Slot timing (Maxim app note 126):
+  Low pulse that starts a slot:  6 us
+  Read sample point:            13 us
+  Write 0 low time:             60 us
+  Recovery between slots:       10 us
+
+Works at 600 kHz and above. At 128 kHz a single
+cbi is longer than the 15 us read window.
+
+  TinyOneWire<PB4> ow;
+  ow.reset();
+  ow.skip();
+  ow.write(0x44); // DS18B20 convert T
+*/
+
+#ifndef TinyOneWire_h
+#define TinyOneWire_h
+
+#include <Arduino.h>
+#include <util/crc16.h>
+
+// Burns exactly "cycles" clock cycles (nothing if cycles <= 0)
+// using the 16-bit register pair %[cnt] as loop counter
+#define TINYONEWIRE_DELAY_MACRO \
+  ".macro ow_delay cycles                    \n" \
+  "  .if (\\cycles) >= 5                     \n" \
+  "    ldi  %A[cnt], lo8(((\\cycles) - 1) / 4) \n" \
+  "    ldi  %B[cnt], hi8(((\\cycles) - 1) / 4) \n" \
+  "  9:                                      \n" \
+  "    sbiw %[cnt], 1                        \n" \
+  "    brne 9b                               \n" \
+  "    .rept ((\\cycles) - 1) %% 4           \n" \
+  "      nop                                 \n" \
+  "    .endr                                 \n" \
+  "  .elseif (\\cycles) > 0                  \n" \
+  "    .rept (\\cycles)                      \n" \
+  "      nop                                 \n" \
+  "    .endr                                 \n" \
+  "  .endif                                  \n" \
+  ".endm                                     \n"
+
+template <uint8_t pin, FastPinClaim claim = PIN_DEFAULT>
+struct TinyOneWire
+{
+  static_assert(F_CPU >= 600000UL, "TinyOneWire: the slot timing needs F_CPU of 600 kHz or more");
+
+  // Timing in clock cycles. Pulses are rounded up, sample points down
+  static constexpr uint16_t lowTime      = (F_CPU / 1000UL * 6 + 999) / 1000;
+  static constexpr uint16_t sampleTime   = F_CPU / 1000UL * 13 / 1000;
+  static constexpr uint16_t slotTime     = (F_CPU / 1000UL * 60 + 999) / 1000;
+  static constexpr uint16_t recovery     = (F_CPU / 1000UL * 10 + 999) / 1000;
+  static constexpr uint16_t resetTime    = (F_CPU / 1000UL * 480 + 999) / 1000;
+  static constexpr uint16_t presenceTime = F_CPU / 1000UL * 70 / 1000;
+  static constexpr uint16_t resetRest    = (F_CPU / 1000UL * 410 + 999) / 1000;
+
+  typedef FastPin<pin, claim> DQ;
+
+  // Release the bus
+  static void begin()
+  {
+    DQ::input();
+    DQ::low(); // Open drain, only DDRB is changed from here on
+  }
+
+  // Reset pulse. Returns true if at least one device answered with a presence pulse
+  static bool reset()
+  {
+    uint8_t sample, oldSREG;
+    uint16_t cnt;
+    DQ::output();
+    __builtin_avr_delay_cycles(resetTime); // Interrupts only make the pulse longer, which is fine
+    asm volatile(
+      TINYONEWIRE_DELAY_MACRO
+      "in   %[sreg], __SREG__             \n" // 1
+      "cli                                \n" // 1
+      "cbi  %[ddrb], %[pin]               \n" // 2  Release, devices answer after 15..60 us
+      "ow_delay (%[wait] - 1)             \n"
+      "in   %[val], %[pinb]               \n" // 1  Presence pulse is low
+      "out  __SREG__, %[sreg]             \n" // 1
+      ".purgem ow_delay                   \n"
+      : [val] "=&r" (sample), [sreg] "=&r" (oldSREG), [cnt] "=&w" (cnt)
+      : [ddrb] "I" (_SFR_IO_ADDR(DDRB)), [pinb] "I" (_SFR_IO_ADDR(PINB)),
+        [pin] "I" (pin), [wait] "n" (presenceTime)
+    );
+    __builtin_avr_delay_cycles(resetRest); // Rest of the presence pulse
+    return !(sample & _BV(pin));
+  }
+
+  // One time slot. Writing a 1 is the same as reading, and returns the bit on the bus
+  static uint8_t touchBit(uint8_t b)
+  {
+    uint8_t sample, oldSREG;
+    uint16_t cnt;
+    asm volatile(
+      TINYONEWIRE_DELAY_MACRO
+      "in   %[sreg], __SREG__             \n" // 1
+      "cli                                \n" // 1
+      "sbi  %[ddrb], %[pin]               \n" // 2  Slot starts, t = 0
+      "ow_delay (%[low] - 3)              \n"
+      "sbrc %[b], 0                       \n" // 1/2
+      "cbi  %[ddrb], %[pin]               \n" // 2  Release at t = low for a 1
+      "ow_delay (%[sample] - %[low] - 1)  \n"
+      "in   %[val], %[pinb]               \n" // 1  t = sample
+      "ow_delay (%[slot] - %[sample] - 2) \n"
+      "cbi  %[ddrb], %[pin]               \n" // 2  Release at t = slot for a 0
+      "out  __SREG__, %[sreg]             \n" // 1
+      ".purgem ow_delay                   \n"
+      : [val] "=&r" (sample), [sreg] "=&r" (oldSREG), [cnt] "=&w" (cnt)
+      : [ddrb] "I" (_SFR_IO_ADDR(DDRB)), [pinb] "I" (_SFR_IO_ADDR(PINB)),
+        [pin] "I" (pin), [b] "r" (b),
+        [low] "n" (lowTime), [sample] "n" (sampleTime), [slot] "n" (slotTime)
+    );
+    __builtin_avr_delay_cycles(recovery);
+    return !!(sample & _BV(pin));
+  }
+
+  static void writeBit(uint8_t b) { touchBit(b); }
+  static uint8_t readBit()        { return touchBit(1); }
+
+  // Bytes are sent LSB first
+  static void write(uint8_t data)
+  {
+    uint8_t i = 8;
+    do
+    {
+      touchBit(data & 0x01);
+      data >>= 1;
+    }
+    while(--i);
+  }
+
+  static uint8_t read()
+  {
+    uint8_t data = 0;
+    uint8_t i = 8;
+    do
+    {
+      data >>= 1;
+      if(touchBit(1))
+        data |= 0x80;
+    }
+    while(--i);
+    return data;
+  }
+
+  // Address the device with this 8 byte ROM code (Match ROM)
+  static void select(const uint8_t *rom)
+  {
+    write(0x55);
+    for(uint8_t i = 0; i < 8; i++)
+      write(rom[i]);
+  }
+
+  // Address all devices, or the only one on the bus (Skip ROM)
+  static void skip()
+  {
+    write(0xCC);
+  }
+
+  // Dallas CRC8. Over a full ROM code or scratchpad including its CRC byte, the result is 0
+  static uint8_t crc8(const uint8_t *buf, uint8_t length)
+  {
+    uint8_t crc = 0;
+    while(length--)
+      crc = _crc_ibutton_update(crc, *buf++);
+    return crc;
+  }
+
+  // Start a new ROM search
+  void resetSearch()
+  {
+    lastDiscrepancy = 0;
+    lastDevice = false;
+  }
+
+  // Finds the next device on the bus (Maxim app note 187). rom must be the same
+  // 8 byte buffer on every call, since it holds the search state between calls.
+  // Returns false when there are no more devices, or on a CRC error
+  bool search(uint8_t *rom)
+  {
+    if(lastDevice || !reset())
+    {
+      resetSearch();
+      return false;
+    }
+    write(0xF0);
+
+    uint8_t lastZero = 0;
+    for(uint8_t id = 1; id <= 64; id++)
+    {
+      const uint8_t idBit = touchBit(1);
+      const uint8_t cmpBit = touchBit(1);
+      if(idBit && cmpBit) // No device answered
+      {
+        resetSearch();
+        return false;
+      }
+
+      uint8_t &romByte = rom[(id - 1) >> 3];
+      const uint8_t mask = _BV((id - 1) & 0x07);
+      uint8_t dir;
+      if(idBit != cmpBit) // All remaining devices have the same bit here
+        dir = idBit;
+      else // Discrepancy
+      {
+        if(id < lastDiscrepancy)
+          dir = romByte & mask; // Same path as last time
+        else
+          dir = (id == lastDiscrepancy);
+        if(!dir)
+          lastZero = id;
+      }
+
+      if(dir)
+        romByte |= mask;
+      else
+        romByte &= ~mask;
+      touchBit(dir ? 1 : 0);
+    }
+
+    lastDiscrepancy = lastZero;
+    if(lastZero == 0)
+      lastDevice = true;
+    return crc8(rom, 8) == 0;
+  }
+
+  private:
+    uint8_t lastDiscrepancy = 0;
+    bool lastDevice = false;
+};
+
+#endif
@@ -0,0 +1,44 @@
+/*
+  Fixed clock SPI
+
+  This example uses the compile-time TinySPI template
+  instead of the SPI object. Mode, bit order and clock
+  divider are fixed when the sketch is compiled, so each
+  byte is sent with an unrolled, cycle exact routine.
+
+  SCK runs at exactly F_CPU / 32, which is 300 kHz at
+  9.6 MHz. Connect a logic analyzer to see the result.
+
+  The circuit:
+  * MOSI - digital pin 0
+  * MISO - digital pin 1
+  * SCK  - digital pin 2
+  * CS   - digital pin 3
+*/
+
+#include <TinySPI.h>
+
+// Mode 0, MSB first, SCK = F_CPU / 32
+TinySPI<SPI_MODE0, MSBFIRST, 32> spi;
+
+const uint8_t slaveSelectPin = 3;
+
+
+void setup()
+{
+  pinMode(slaveSelectPin, OUTPUT);
+  digitalWrite(slaveSelectPin, HIGH);
+  spi.begin();
+}
+
+
+void loop()
+{
+  for(uint8_t value = 0; value < 255; value++)
+  {
+    digitalWrite(slaveSelectPin, LOW);
+    spi.transfer(value);
+    digitalWrite(slaveSelectPin, HIGH);
+    delay(10);
+  }
+}
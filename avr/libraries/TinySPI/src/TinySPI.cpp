@@ -147,6 +147,60 @@ uint8_t TinySoftSPIClass::transfer(uint8_t _data)
 }
 
 
+// MSB first sends the high byte first, LSB first sends the low byte first
+uint16_t TinySoftSPIClass::transfer16(uint16_t _data)
+{
+  uint8_t hi = _data >> 8;
+  uint8_t lo = _data;
+  if(_bitOrder == MSBFIRST)
+  {
+    hi = transfer(hi);
+    lo = transfer(lo);
+  }
+  else
+  {
+    lo = transfer(lo);
+    hi = transfer(hi);
+  }
+  return (hi << 8) | lo;
+}
+
+
+// Full duplex, every byte in _buf is replaced by the byte received
+void TinySoftSPIClass::transfer(void *_buf, size_t _count)
+{
+  uint8_t *p = (uint8_t *)_buf;
+  while(_count--)
+  {
+    *p = transfer(*p);
+    p++;
+  }
+}
+
+
+// Write only. The runtime class has one bit loop per mode, all of them reading
+// MISO, so these are no faster than transfer(). They're here to match TinySPI<>
+void TinySoftSPIClass::transferOut(uint8_t _data)
+{
+  transfer(_data);
+}
+
+
+void TinySoftSPIClass::transferOut(const uint8_t *_buf, size_t _count)
+{
+  while(_count--)
+    transfer(*_buf++);
+}
+
+
+// Write only from a PROGMEM buffer
+void TinySoftSPIClass::transferOutP(const uint8_t *_buf, size_t _count)
+{
+  while(_count--)
+    transfer(pgm_read_byte(_buf++));
+}
+
+
 void TinySoftSPIClass::setBitOrder(uint8_t bitOrder)
 {
   _bitOrder = bitOrder;
@@ -178,20 +232,14 @@ void TinySoftSPIClass::setDataMode(uint8_t mode)
 
 void TinySoftSPIClass::setClockDivider(__attribute__((unused)) uint8_t rate) 
 {
-  // Not Implemented, @TODO
+  // Not Implemented for the runtime class
   //
   // There is a good chance that the code is already so slow as to make
-  // this pointless.
-  //
-  // Otherwise we would need to insert some delays in the transferModeN 
-  // methods on both sides of the clock based on cpu frequency and  
-  // expected clock counts for the loops themselves, pretty tricky.
+  // this pointless, and runtime delays would cost flash even if they were
+  // never used.
   //
-  // It would mean increase flash cost even if it wasn't needed
-  // maybe if we had some special methods like ::delayClock8 and 
-  // used function pointers like with transferModeN the optimiser
-  // would be able to be smart about it and see that they were not
-  // used if setClockDivider wasn't used.
+  // Use TinySPI<Mode, BitOrder, Divider> from TinySPI.h instead, which has
+  // cycle exact timing and an SCK frequency of F_CPU / Divider.
 }
 
 
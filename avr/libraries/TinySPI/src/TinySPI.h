@@ -12,6 +12,11 @@
  *   - Get rid of "unused parameter" warnings by adding the unused attribute
  *   - Add examples
  *
+ * Modified by MCUdude
+ *   - Add the compile-time TinySPI<Mode, BitOrder, Divider> template with
+ *       an unrolled, fixed-cycle transfer and a working clock divider
+ *   - Add block, 16-bit and write-only transfers
+ *
  * Modified 2017 by James Sleeman
  *   - Use only the "Hard Coded" (in pins_arduino.h for each variant) MOSI/MISO/SCK
  *   - Do not do anything with SS, leave this up to the user, this is Master only anyway
@@ -35,6 +40,7 @@
 
 #include <stdio.h>
 #include <Arduino.h>
+#include <avr/pgmspace.h>
 
 #define SPI_MODE0 0
 #define SPI_MODE1 1
@@ -97,6 +103,11 @@ class TinySoftSPIClass
   public:
     void begin();
     uint8_t transfer(uint8_t _data);
+    uint16_t transfer16(uint16_t _data);
+    void transfer(void *_buf, size_t _count);
+    void transferOut(uint8_t _data);
+    void transferOut(const uint8_t *_buf, size_t _count);
+    void transferOutP(const uint8_t *_buf, size_t _count);
     void end();
     
     void setBitOrder(uint8_t);
@@ -114,4 +125,179 @@ class TinySoftSPIClass
 };
 
 extern TinySoftSPIClass SPI;
+
+
+// Compile-time specialized SPI master
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Mode, bit order and clock divider are template parameters, so transfer()
+// boils down to an unrolled assembly sequence with no runtime decisions.
+// Every bit takes exactly Divider clock cycles, giving SCK = F_CPU / Divider.
+// The fastest possible SCK is F_CPU / 8, or F_CPU / 6 for an instance that
+// only uses transferOut() and transferOutP(). Example:
+//
+//   TinySPI<SPI_MODE0, MSBFIRST, 16> spi; // 600 kHz SCK at 9.6 MHz
+//   spi.begin();
+//   uint8_t reply = spi.transfer(0x42);
+//
+// transferOut() and transferOutP() send a byte, or a RAM or PROGMEM buffer, without
+// sampling MISO. A write-only bit is 5 cycles of work instead of 7, so at the same
+// Divider it takes as long as a full duplex one, but Divider can go down to 6.
+// transfer(buf, count) does an in-place full duplex transfer of a buffer.
+//
+// Interrupts are disabled during each byte to keep the timing exact.
+// Uses the same MOSI, MISO and SCK pins as the SPI object.
+
+template <uint8_t Mode = SPI_MODE0, uint8_t BitOrder = MSBFIRST, uint8_t Divider = 8>
+struct TinySPI
+{
+  static_assert(Mode <= SPI_MODE3, "TinySPI: Mode must be SPI_MODE0..SPI_MODE3");
+  static_assert(BitOrder == MSBFIRST || BitOrder == LSBFIRST, "TinySPI: BitOrder must be MSBFIRST or LSBFIRST");
+  static_assert(Divider >= 6, "TinySPI: SCK can't be faster than F_CPU / 6");
+
+  // Resulting SCK frequency in Hz
+  static constexpr uint32_t clock = F_CPU / Divider;
+
+  static void begin()
+  {
+    DDRB |= _BV(MOSI) | _BV(SCK);
+    DDRB &= ~_BV(MISO);
+    // SCK idles high in mode 2 and 3
+    if(Mode & 0x02)
+      PORTB |= _BV(SCK);
+    else
+      PORTB &= ~_BV(SCK);
+  }
+
+  static void end() {}
+
+  static uint8_t transfer(uint8_t data) { return shift<true>(data); }
+
+  // MSB first sends the high byte first, LSB first sends the low byte first
+  static uint16_t transfer16(uint16_t data)
+  {
+    uint8_t hi = data >> 8;
+    uint8_t lo = data;
+    if(BitOrder == MSBFIRST)
+    {
+      hi = shift<true>(hi);
+      lo = shift<true>(lo);
+    }
+    else
+    {
+      lo = shift<true>(lo);
+      hi = shift<true>(hi);
+    }
+    return (hi << 8) | lo;
+  }
+
+  // Full duplex, every byte in buf is replaced by the byte received
+  static void transfer(void *buf, size_t count)
+  {
+    uint8_t *p = (uint8_t *)buf;
+    while(count--)
+    {
+      *p = shift<true>(*p);
+      p++;
+    }
+  }
+
+  // Write only, MISO is ignored
+  static void transferOut(uint8_t data) { shift<false>(data); }
+
+  static void transferOut(const uint8_t *buf, size_t count)
+  {
+    while(count--)
+      shift<false>(*buf++);
+  }
+
+  // Write only from a PROGMEM buffer, MISO is ignored
+  static void transferOutP(const uint8_t *buf, size_t count)
+  {
+    while(count--)
+      shift<false>(pgm_read_byte(buf++));
+  }
+
+  private:
+  // Shifts one byte out and, if Read is true, one byte in
+  template <bool Read>
+  static uint8_t shift(uint8_t data)
+  {
+    static_assert(!Read || Divider >= 8, "TinySPI: SCK can't be faster than F_CPU / 8 when reading, only transferOut() can use a Divider of 6");
+    uint8_t port, cnt;
+    uint8_t oldSREG = SREG;
+    cli();
+
+    // Each bit: out PORTB puts the next MOSI bit out together with the first SCK edge,
+    // out PINB toggles SCK for the second edge, and MISO is sampled right after it.
+    // That's 4 cycles before the toggle and 3 cycles after it, the rest is padding.
+    // Without Read the next MOSI bit is prepared after the toggle instead, which
+    // leaves 3 cycles before it and 2 after it.
+    // In mode 0 and 2 the first out PORTB of a byte keeps SCK at its idle level.
+    asm volatile(
+      ".macro tinyspi_delay cycles        \n"
+      "  .if \\cycles / 3                 \n"
+      "    ldi  %[cnt], \\cycles / 3      \n" // 3 cycles per loop
+      "  1:                               \n"
+      "    dec  %[cnt]                    \n"
+      "    brne 1b                        \n"
+      "  .endif                           \n"
+      "  .rept \\cycles %% 3              \n"
+      "    nop                            \n"
+      "  .endr                            \n"
+      ".endm                              \n"
+      "in   %[port], %[portb]             \n"
+      ".if %[sckout]                      \n"
+      "ori  %[port], %[sckmask]           \n"
+      ".else                              \n"
+      "andi %[port], lo8(~%[sckmask])     \n"
+      ".endif                             \n"
+      "bst  %[data], %[firstbit]          \n"
+      "bld  %[port], %[mosi]              \n"
+      ".rept 8                            \n"
+      "out  %[portb], %[port]             \n" // MOSI out, first SCK edge
+      ".if %[msb]                         \n"
+      "lsl  %[data]                       \n"
+      "bst  %[data], 7                    \n"
+      ".else                              \n"
+      "lsr  %[data]                       \n"
+      "bst  %[data], 0                    \n"
+      ".endif                             \n"
+      ".if %[read]                        \n"
+      "bld  %[port], %[mosi]              \n" // Prepare the next MOSI bit
+      "tinyspi_delay %[delay1]            \n"
+      "out  %[pinb], %[sck]               \n" // Second SCK edge
+      "sbic %[pinb], %[miso]              \n" // Sample MISO
+      "ori  %[data], %[inbit]             \n"
+      "tinyspi_delay %[delay2]            \n"
+      ".else                              \n"
+      "tinyspi_delay %[delay1]            \n"
+      "out  %[pinb], %[sck]               \n" // Second SCK edge
+      "bld  %[port], %[mosi]              \n" // Prepare the next MOSI bit
+      "tinyspi_delay %[delay2]            \n"
+      ".endif                             \n"
+      ".endr                              \n"
+      ".if %[cphazero]                    \n"
+      "out  %[pinb], %[sck]               \n" // Back to idle level
+      ".endif                             \n"
+      ".purgem tinyspi_delay              \n"
+      : [data] "+d" (data), [port] "=&d" (port), [cnt] "=&d" (cnt)
+      : [sck] "r" ((uint8_t)_BV(SCK)),
+        [portb] "I" (_SFR_IO_ADDR(PORTB)), [pinb] "I" (_SFR_IO_ADDR(PINB)),
+        [mosi] "I" (MOSI), [miso] "I" (MISO), [sckmask] "M" (_BV(SCK)),
+        [sckout] "n" (Mode == SPI_MODE1 || Mode == SPI_MODE2),
+        [cphazero] "n" (!(Mode & 0x01)),
+        [read] "n" (Read),
+        [msb] "n" (BitOrder == MSBFIRST),
+        [firstbit] "n" (BitOrder == MSBFIRST ? 7 : 0),
+        [inbit] "M" (BitOrder == MSBFIRST ? 0x01 : 0x80),
+        [delay1] "n" (Divider / 2 - (Read ? 4 : 3)),
+        [delay2] "n" (Divider - Divider / 2 - (Read ? 3 : 2))
+    );
+
+    SREG = oldSREG;
+    return data;
+  }
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+/*
+  Chime
+
+  Plays a short two tone chime from 4-bit IMA ADPCM data in
+  flash every time the button is pressed. 480 samples at
+  8 kHz fit in 240 bytes.
+
+  The circuit:
+  * Speaker with a 10uF series capacitor, or a piezo buzzer, on
+    digital pin 0 (OC0A). Add a 1k resistor and 100nF to GND
+    as a low pass filter in front of an amplifier
+  * Pushbutton from digital pin 3 to GND
+*/
+
+#include <TinySample.h>
+
+// Decaying C6 + G6, 8 kHz IMA ADPCM
+const uint8_t chime[] PROGMEM =
+{
+  0x70, 0x77, 0xFF, 0x3F, 0x73, 0x77, 0xFD, 0x39, 0x15, 0xBA, 0x19, 0x01, 0x20, 0xA1, 0xAF, 0x52,
+  0x81, 0x9C, 0x10, 0x81, 0x11, 0xD8, 0x1B, 0x25, 0xC0, 0x0A, 0x11, 0x18, 0x01, 0xCC, 0x49, 0x14,
+  0xBB, 0x18, 0x01, 0x20, 0xB1, 0xAF, 0x53, 0x91, 0x9C, 0x11, 0x00, 0x20, 0xD9, 0x1B, 0x26, 0xB8,
+  0x0B, 0x12, 0x18, 0x01, 0xCD, 0x48, 0x04, 0xBB, 0x28, 0x01, 0x20, 0xB0, 0x9F, 0x52, 0x91, 0x9C,
+  0x11, 0x81, 0x11, 0xDA, 0x2A, 0x25, 0xB9, 0x0B, 0x13, 0x18, 0x92, 0xCE, 0x50, 0x02, 0xBB, 0x28,
+  0x82, 0x20, 0xD0, 0x9C, 0x44, 0xA1, 0x9C, 0x12, 0x00, 0x10, 0xDA, 0x2A, 0x26, 0xBA, 0x1A, 0x12,
+  0x18, 0x91, 0xBE, 0x61, 0x82, 0xBB, 0x20, 0x82, 0x10, 0xD0, 0x8C, 0x44, 0xA0, 0x8C, 0x21, 0x80,
+  0x01, 0xEA, 0x29, 0x15, 0xC9, 0x19, 0x02, 0x08, 0x91, 0xAC, 0x61, 0x82, 0xAC, 0x20, 0x81, 0x10,
+  0xC8, 0x8B, 0x36, 0xB0, 0x8C, 0x12, 0x00, 0x00, 0xEB, 0x49, 0x14, 0xCA, 0x19, 0x02, 0x00, 0x90,
+  0xAD, 0x52, 0x92, 0xAC, 0x21, 0x81, 0x10, 0xC9, 0x0B, 0x27, 0xC0, 0x8A, 0x22, 0x08, 0x00, 0xDB,
+  0x48, 0x04, 0xCA, 0x29, 0x02, 0x08, 0x90, 0xAD, 0x63, 0x91, 0x9C, 0x21, 0x00, 0x08, 0xC8, 0x1B,
+  0x36, 0xC8, 0x0B, 0x22, 0x80, 0x80, 0xDB, 0x58, 0x04, 0xBB, 0x29, 0x03, 0x08, 0xA0, 0x9E, 0x63,
+  0xA1, 0x9C, 0x21, 0x81, 0x00, 0xC9, 0x1A, 0x27, 0xB9, 0x1B, 0x22, 0x88, 0x81, 0xCC, 0x50, 0x03,
+  0xBC, 0x28, 0x83, 0x08, 0xB0, 0x9D, 0x54, 0xA1, 0x9C, 0x31, 0x80, 0x08, 0xC9, 0x3A, 0x26, 0xD9,
+  0x09, 0x22, 0x88, 0x90, 0xCA, 0x60, 0x83, 0xBC, 0x20, 0x02, 0x88, 0xB0, 0x8C, 0x45, 0xA0, 0x8D,
+};
+
+
+void setup()
+{
+  pinMode(3, INPUT_PULLUP);
+}
+
+
+void loop()
+{
+  if(!digitalRead(3) && !TinySample.isPlaying())
+    TinySample.playADPCM(chime, sizeof(chime), SAMPLE_RATE(8000));
+}
@@ -0,0 +1,140 @@
+/*** MicroCore - TinySample.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Plays sounds stored in flash on OC0A (PB0) in
+the background. Timer0 runs fast PWM without a
+prescaler, and a sample interrupt in assembly
+runs once per PWM period. It adds the rate to a
+16-bit accumulator, and fetches the next sample
+every time the accumulator overflows. Any sample
+rate up to F_CPU / 256 works.
+
+Two formats are supported, each with its own
+interrupt. The library is linked as an archive
+(dot_a_linkage), so a sketch only gets the
+decoder it uses. Using both in one sketch fails
+to link, since both are TIM0_COMPB_vect:
+  - 8-bit unsigned PCM (TinySamplePCM.S)
+  - 4-bit IMA ADPCM (TinySampleADPCM.S), low
+    nibble first, as in the data blocks of an IMA
+    ADPCM WAV file with the 4 byte block headers
+    left out. Decoding starts from 0 with step
+    index 0. The step table takes 178 bytes
+
+Flash is what limits the length. With around
+600 bytes left for sound, 8-bit PCM at 8 kHz
+lasts 75 ms, and ADPCM (after its step table)
+about 100 ms. Lower rates last longer, 4 kHz is
+fine for short voice prompts and beeps.
+
+  TinySample.playADPCM(chime, sizeof(chime), SAMPLE_RATE(8000));
+
+The output needs a low pass filter, or a speaker
+with a series capacitor. Timer0 is used for the
+sound, so analogWrite() and tone() are ignored
+while it plays, and enabling micros() is a
+compile error. After a sound,
+PB0 rests at the middle level (OCR0A = 128) until
+end() is called, and Timer0 stays with TinySample
+until then, so tone() is ignored. The play
+functions return false while another library
+owns Timer0. Servo, TinySoftPWM, TinySynth and
+TinyDDS also use TIM0_COMPB_vect, so they don't
+link together with TinySample.
+*/
+
+#ifndef TinySample_h
+#define TinySample_h
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+#if defined(ENABLE_MICROS)
+  #error "TinySample can't be used together with micros(), disable micros"
+#endif
+
+// Rate accumulator increment for a constant sample rate in Hz. Rates above
+// F_CPU / 256 play at F_CPU / 256
+#define SAMPLE_RATE(hz) ((hz) * 16777216.0 / F_CPU >= 65535.0 ? 0xFFFF : (uint16_t)((hz) * 16777216.0 / F_CPU + 0.5))
+
+extern "C"
+{
+  // Defined in TinySamplePCM.S
+  extern volatile uint16_t pcm_acc;
+  extern volatile uint16_t pcm_rate;
+  extern const uint8_t *volatile pcm_ptr;
+  extern volatile uint16_t pcm_left;
+
+  // Defined in TinySampleADPCM.S
+  extern volatile uint16_t adpcm_acc;
+  extern volatile uint16_t adpcm_rate;
+  extern const uint8_t *volatile adpcm_ptr;
+  extern volatile uint16_t adpcm_left;
+  extern volatile uint16_t adpcm_sample;
+  extern volatile uint8_t adpcm_index;
+}
+
+struct TinySampleClass
+{
+  // length bytes of 8-bit unsigned PCM from PROGMEM
+  bool playPCM(const uint8_t *data, uint16_t length, uint16_t rate)
+  {
+    if(!timer0Claim(TIMER0_AUDIO))
+      return false;
+    stop();
+    pcm_ptr = data;
+    pcm_left = length;
+    pcm_rate = rate;
+    pcm_acc = 0;
+    return start();
+  }
+
+  // length bytes (twice as many samples) of IMA ADPCM from PROGMEM
+  bool playADPCM(const uint8_t *data, uint16_t length, uint16_t rate)
+  {
+    if(!timer0Claim(TIMER0_AUDIO))
+      return false;
+    stop();
+    adpcm_ptr = data;
+    adpcm_left = length * 2;
+    adpcm_rate = rate;
+    adpcm_acc = 0;
+    adpcm_sample = 0x8000;
+    adpcm_index = 0;
+    return start();
+  }
+
+  // Stop right away, PB0 rests at the middle level
+  void stop()
+  {
+    if(timer0_owner != TIMER0_AUDIO)
+      return;
+    TIMSK0 &= ~_BV(OCIE0B);
+    OCR0A = 0x80;
+  }
+
+  // Stop and leave PB0 low
+  void end()
+  {
+    stop();
+    timer0AudioEnd();
+  }
+
+  // The interrupt switches itself off after the last sample
+  bool isPlaying()
+  {
+    return TIMSK0 & _BV(OCIE0B);
+  }
+
+  private:
+  static bool start()
+  {
+    return timer0AudioBegin(0x80);
+  }
+};
+
+static TinySampleClass TinySample;
+
+#endif
@@ -0,0 +1,49 @@
+/*
+  RGB fade
+
+  Fades a common cathode RGB LED through the color wheel,
+  with software PWM on three pins that have no hardware PWM.
+
+  The circuit:
+  * Red LED anode on digital pin 2 through a 220 ohm resistor
+  * Green LED anode on digital pin 3 through a 220 ohm resistor
+  * Blue LED anode on digital pin 4 through a 220 ohm resistor
+  * Common cathode to GND
+*/
+
+#include <TinySoftPWM.h>
+
+uint8_t hue;
+
+
+void setup()
+{
+  SoftPWM.begin(_BV(PB2) | _BV(PB3) | _BV(PB4));
+}
+
+
+void loop()
+{
+  // Three overlapping ramps make the color wheel
+  const uint8_t phase = hue % 85 * 3;
+  if(hue < 85)
+  {
+    SoftPWM.write(PB2, 255 - phase);
+    SoftPWM.write(PB3, phase);
+    SoftPWM.write(PB4, 0);
+  }
+  else if(hue < 170)
+  {
+    SoftPWM.write(PB2, 0);
+    SoftPWM.write(PB3, 255 - phase);
+    SoftPWM.write(PB4, phase);
+  }
+  else
+  {
+    SoftPWM.write(PB2, phase);
+    SoftPWM.write(PB3, 0);
+    SoftPWM.write(PB4, 255 - phase);
+  }
+  hue++;
+  delay(20);
+}
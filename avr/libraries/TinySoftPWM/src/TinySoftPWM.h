@@ -0,0 +1,129 @@
+/*** MicroCore - TinySoftPWM.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+8-bit software PWM on any of PB0..PB5, using bit
+angle modulation. A period is split into eight
+slots of 1, 2, 4 .. 128 units, and in slot k a
+channel is high if bit k of its duty cycle is
+set. Every slot is one interrupt that writes all
+channels to PORTB at once, so the cost is eight
+interrupts of about 62 cycles per period, the
+same for one channel as for six.
+
+Timer0 free runs with a /64 prescaler, and the
+slots come from the compare match B interrupt:
+
+| Clock   | Unit       | PWM frequency | CPU  |
+|---------|------------|---------------|------|
+| 20 MHz  | 128 cycles | 613 Hz        | 1.5% |
+| 16 MHz  | 128 cycles | 490 Hz        | 1.5% |
+| 12 MHz  | 128 cycles | 368 Hz        | 1.5% |
+| 9.6 MHz | 128 cycles | 294 Hz        | 1.5% |
+| 8 MHz   | 128 cycles | 245 Hz        | 1.5% |
+| 4.8 MHz | 128 cycles | 147 Hz        | 1.5% |
+
+F_CPU has to be 4.8 MHz or more. A unit has to
+be longer than the 62 cycle interrupt plus the
+time WDT_vect can hold it up, or OCR0B is moved
+past a compare match that has already gone by,
+and that slot gets 256 ticks too long. Below
+4.8 MHz a 128 cycle unit makes LEDs flicker,
+and a shorter one would give that glitch.
+
+With the /64 prescaler and the timer left in
+normal mode, micros() keeps working. analogWrite()
+and tone() are ignored from begin() until end(),
+and so are TinyIRSender and TinyIRReceiver.
+begin() returns false while one of them owns
+Timer0. Servo, TinySynth, TinyDDS and TinySample
+also use TIM0_COMPB_vect, so a sketch with one
+of them fails to link.
+
+The interrupt writes the whole PORTB, so other
+pins should be changed with digitalWrite() or
+FastPin, which touch one bit at a time. A new
+duty cycle takes effect right away, so the
+period it's written in can be a mix of the old
+and the new value.
+
+  SoftPWM.begin(_BV(PB2) | _BV(PB3) | _BV(PB4));
+  SoftPWM.write(PB3, 128);
+*/
+
+#ifndef TinySoftPWM_h
+#define TinySoftPWM_h
+
+#include <Arduino.h>
+
+static_assert(F_CPU >= 4800000UL, "TinySoftPWM needs F_CPU of 4.8 MHz or more");
+
+// Timer ticks per unit, must match UNIT in TinySoftPWM.S
+#define SOFTPWM_UNIT 2
+
+extern "C"
+{
+  // Defined in TinySoftPWM.S
+  extern volatile uint8_t softpwm_planes[8];
+  extern volatile uint8_t softpwm_keep;
+  extern volatile uint8_t softpwm_bit;
+  extern volatile uint8_t softpwm_slot;
+}
+
+struct TinySoftPWMClass
+{
+  // Start PWM on the pins in mask (bit n is PBn), all at 0. Returns false if
+  // another library owns Timer0
+  bool begin(uint8_t mask)
+  {
+    if(!timer0Claim(TIMER0_SOFTPWM))
+      return false;
+    for(uint8_t i = 0; i < 8; i++)
+      softpwm_planes[i] = 0;
+    softpwm_keep = ~mask;
+    PORTB &= ~mask;
+    DDRB |= mask;
+    cli();
+    TCCR0A = 0; // Normal mode, OC0A and OC0B disconnected
+    TCCR0B = _BV(CS01) | _BV(CS00);
+    softpwm_bit = 0;
+    softpwm_slot = SOFTPWM_UNIT;
+    OCR0B = TCNT0 + 2;
+    TIFR0 = _BV(OCF0B);
+    TIMSK0 |= _BV(OCIE0B);
+    sei(); // PWM needs interrupts, so don't restore SREG
+    return true;
+  }
+
+  // Stop the interrupt and leave the PWM pins low. Timer0 keeps running
+  void end()
+  {
+    if(timer0_owner != TIMER0_SOFTPWM)
+      return;
+    TIMSK0 &= ~_BV(OCIE0B);
+    PORTB &= softpwm_keep;
+    timer0Release(TIMER0_SOFTPWM);
+  }
+
+  // Duty cycle 0..255 of a pin given to begin(), other pins are ignored
+  void write(uint8_t pin, uint8_t value)
+  {
+    const uint8_t mask = _BV(pin) & ~softpwm_keep;
+    uint8_t oldSREG = SREG;
+    cli();
+    for(uint8_t i = 0; i < 8; i++)
+    {
+      if(value & 0x01)
+        softpwm_planes[i] |= mask;
+      else
+        softpwm_planes[i] &= ~mask;
+      value >>= 1;
+    }
+    SREG = oldSREG;
+  }
+};
+
+static TinySoftPWMClass SoftPWM;
+
+#endif
@@ -0,0 +1,46 @@
+/*
+  Chords
+
+  Plays a four chord progression with three voices, and
+  switches to XORed voices while the button is held down.
+
+  The circuit:
+  * Piezo buzzer, or an RC filter and an amplifier, on digital pin 0 (OC0A)
+  * Pushbutton from digital pin 3 to GND
+*/
+
+#include <TinySynth.h>
+
+// MIDI notes, three per chord: C major, A minor, F major, G major
+const uint8_t chords[4][3] PROGMEM =
+{
+  { 60, 64, 67 },
+  { 57, 60, 64 },
+  { 53, 57, 60 },
+  { 55, 59, 62 },
+};
+
+uint8_t chord;
+uint32_t lastChange;
+
+
+void setup()
+{
+  pinMode(3, INPUT_PULLUP);
+  TinySynth.begin();
+}
+
+
+void loop()
+{
+  // Use millis() for timing, delay() is slowed down by the sample interrupt
+  if(millis() - lastChange >= 800)
+  {
+    lastChange = millis();
+    for(uint8_t voice = 0; voice < SYNTH_VOICES; voice++)
+      TinySynth.noteOn(voice, pgm_read_byte(&chords[chord][voice]));
+    chord = (chord + 1) & 0x03;
+  }
+
+  TinySynth.setXor(!digitalRead(3));
+}
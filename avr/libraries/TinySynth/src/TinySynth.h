@@ -0,0 +1,140 @@
+/*** MicroCore - TinySynth.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+Three voice square wave synthesizer. Timer0
+runs fast PWM without a prescaler, and a sample
+interrupt in assembly (TinySynth.S) steps three
+16-bit phase accumulators once per PWM period.
+The voices are either mixed, or XORed into one
+square wave for a harsher, ring modulated sound.
+The output is OC0A (PB0), use an RC filter or
+just a piezo.
+
+The cost is a fixed 91 cycles out of every 256,
+so the synth takes 36% of the CPU no matter how
+many voices play:
+
+| Clock   | Sample rate | Frequency step |
+|---------|-------------|----------------|
+| 20 MHz  | 78.1 kHz    | 1.19 Hz        |
+| 16 MHz  | 62.5 kHz    | 0.95 Hz        |
+| 12 MHz  | 46.9 kHz    | 0.72 Hz        |
+| 9.6 MHz | 37.5 kHz    | 0.57 Hz        |
+| 8 MHz   | 31.3 kHz    | 0.48 Hz        |
+| 4.8 MHz | 18.8 kHz    | 0.29 Hz        |
+| 1.2 MHz | 4.69 kHz    | 0.07 Hz        |
+
+Notes above a quarter of the sample rate get
+audibly out of tune, so 4.8 MHz and up is best.
+
+Timer0 is used for the synth, so analogWrite()
+and tone() are ignored while it runs. micros()
+would add its overflow interrupt to the load,
+so enabling it is a compile error.
+begin() returns false while another library
+owns Timer0, and tone() is ignored until end().
+Servo, TinySoftPWM, TinyDDS and TinySample also
+use TIM0_COMPB_vect, so they don't link together
+with TinySynth.
+millis() works as usual, but delay() is a
+busy loop, so it lasts about 1.5 times longer.
+
+  TinySynth.begin();
+  TinySynth.noteOn(0, 60);                    // Middle C
+  TinySynth.setIncrement(1, SYNTH_HZ(440));   // A4
+*/
+
+#ifndef TinySynth_h
+#define TinySynth_h
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+#if defined(ENABLE_MICROS)
+  #error "TinySynth can't be used together with micros(), disable micros"
+#endif
+
+#define SYNTH_VOICES 3
+
+// Phase increment for a constant frequency in Hz, 65536 is one cycle per sample
+#define SYNTH_HZ(hz) ((uint16_t)((hz) * 16777216.0 / F_CPU + 0.5))
+
+extern "C"
+{
+  // Defined in TinySynth.S
+  extern volatile uint16_t synth_phase[SYNTH_VOICES];
+  extern volatile uint16_t synth_increment[SYNTH_VOICES];
+  extern volatile uint8_t synth_xor;
+}
+
+// Increments of the highest octave noteOn() handles, C7 (96) to B7 (107).
+// Lower octaves are these shifted right. Saturates at clocks too low for them
+#define SYNTH_NOTE(hz) ((hz) * 16777216.0 / F_CPU + 0.5 > 65535.0 ? 0xFFFF : SYNTH_HZ(hz))
+static const uint16_t synth_notes[12] PROGMEM =
+{
+  SYNTH_NOTE(2093.00), SYNTH_NOTE(2217.46), SYNTH_NOTE(2349.32), SYNTH_NOTE(2489.02),
+  SYNTH_NOTE(2637.02), SYNTH_NOTE(2793.83), SYNTH_NOTE(2959.96), SYNTH_NOTE(3135.96),
+  SYNTH_NOTE(3322.44), SYNTH_NOTE(3520.00), SYNTH_NOTE(3729.31), SYNTH_NOTE(3951.07),
+};
+
+struct TinySynthClass
+{
+  // Take over Timer0 and start the sample interrupt. Returns false if another
+  // library owns Timer0
+  bool begin(bool xorVoices = false)
+  {
+    synth_xor = xorVoices;
+    return timer0AudioBegin(0);
+  }
+
+  // Stop the sample interrupt and leave PB0 low
+  void end()
+  {
+    timer0AudioEnd();
+  }
+
+  // Raw phase increment, see SYNTH_HZ()
+  void setIncrement(uint8_t voice, uint16_t increment)
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    synth_increment[voice] = increment;
+    SREG = oldSREG;
+  }
+
+  // Play a MIDI note (60 is middle C, up to 107) on a voice
+  void noteOn(uint8_t voice, uint8_t note)
+  {
+    if(note > 107)
+      return;
+    uint8_t shift = 0;
+    while(note < 96)
+    {
+      note += 12;
+      shift++;
+    }
+    setIncrement(voice, pgm_read_word(&synth_notes[note - 96]) >> shift);
+  }
+
+  // Silence a voice. Its phase is reset too, so it doesn't add to the mix
+  void noteOff(uint8_t voice)
+  {
+    uint8_t oldSREG = SREG;
+    cli();
+    synth_increment[voice] = 0;
+    synth_phase[voice] = 0;
+    SREG = oldSREG;
+  }
+
+  // Switch between mixed and XORed voices
+  void setXor(bool xorVoices)
+  {
+    synth_xor = xorVoices;
+  }
+};
+
+static TinySynthClass TinySynth;
+
+#endif
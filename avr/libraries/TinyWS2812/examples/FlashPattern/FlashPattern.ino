@@ -0,0 +1,43 @@
+/*
+  Flash pattern
+
+  Cycles an 8 LED WS2812B strip through a few frames stored in
+  flash. Frames in PROGMEM don't use any of the 64 bytes of RAM.
+
+  The circuit:
+  * Strip DIN to digital pin 4, through a 330 ohm resistor
+  * Strip GND to GND and 5V to a supply that can drive the LEDs
+
+  Needs a clock of 8 MHz or more.
+*/
+
+#include <TinyWS2812.h>
+
+const uint8_t numLeds = 8;
+
+// G, R, B for every LED
+const uint8_t frames[][numLeds * 3] PROGMEM =
+{
+  { 0,32,0,  0,0,0,   0,0,0,   0,0,0,   0,0,0,   0,0,0,   0,0,0,   0,0,0  },
+  { 0,0,0,   32,0,0,  0,0,0,   0,0,0,   0,0,0,   0,0,0,   0,0,0,   32,0,0 },
+  { 0,0,0,   0,0,0,   0,0,32,  0,0,0,   0,0,0,   0,0,32,  0,0,0,   0,0,0  },
+  { 0,0,0,   0,0,0,   0,0,0,   32,32,32, 32,32,32, 0,0,0, 0,0,0,   0,0,0  },
+};
+
+TinyWS2812<PB4> strip;
+
+
+void setup()
+{
+  strip.begin();
+}
+
+
+void loop()
+{
+  for(uint8_t i = 0; i < sizeof(frames) / sizeof(frames[0]); i++)
+  {
+    strip.writeP(frames[i], sizeof(frames[0]));
+    delay(200);
+  }
+}
@@ -0,0 +1,65 @@
+/*
+  Rainbow
+
+  Scrolls a rainbow along a 120 LED WS2812B strip. The strip
+  needs 360 bytes of color data, far more than the 64 bytes of
+  RAM, so every pixel is computed by a callback just before it
+  is sent.
+
+  The circuit:
+  * Strip DIN to digital pin 4, through a 330 ohm resistor
+  * Strip GND to GND and 5V to a supply that can drive the LEDs
+
+  Needs a clock of 8 MHz or more.
+*/
+
+#include <TinyWS2812.h>
+
+const uint16_t numLeds = 120;
+
+TinyWS2812<PB4> strip;
+uint8_t offset;
+
+
+// Color wheel with 3 x 85 steps. Kept short, since it runs
+// between two pixels while the data line is low
+void rainbow(uint16_t index, uint8_t *pixel)
+{
+  uint8_t pos = (uint8_t)index * 2 + offset;
+  uint8_t up, down;
+  if(pos < 85)
+  {
+    up = pos * 3;
+    pixel[0] = up;        // G
+    pixel[1] = 255 - up;  // R
+    pixel[2] = 0;         // B
+  }
+  else if(pos < 170)
+  {
+    down = (pos - 85) * 3;
+    pixel[0] = 255 - down;
+    pixel[1] = 0;
+    pixel[2] = down;
+  }
+  else
+  {
+    up = (pos - 170) * 3;
+    pixel[0] = 0;
+    pixel[1] = up;
+    pixel[2] = 255 - up;
+  }
+}
+
+
+void setup()
+{
+  strip.begin();
+}
+
+
+void loop()
+{
+  strip.write(numLeds, rainbow);
+  offset++;
+  delay(20);
+}
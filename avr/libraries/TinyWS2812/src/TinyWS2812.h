@@ -0,0 +1,195 @@
+/*** MicroCore - TinyWS2812.h ***
+An Arduino core designed for ATtiny13
+File created and maintained by MCUdude
+https://github.com/MCUdude/MicroCore
+
+WS2812B, SK6812 and WS2811 LED strip driver on
+any PORTB pin. Pixels can come from a RAM buffer,
+a PROGMEM buffer, or a callback that computes
+every pixel while the strip is written. With the
+callback, the strip can be far longer than the
+64 bytes of RAM would allow.
+
+The bit timing is generated at compile time from
+F_CPU and padded with nops, so every bit has the
+same high time in clock cycles (T0H/T1H/period).
+The last bit of every byte is low for 6 cycles
+longer (7 from PROGMEM, more between pixels from
+a callback), which is well within what the LEDs
+accept:
+
+| Clock   | T0H            | T1H            | Period          |
+|---------|----------------|----------------|-----------------|
+| 20 MHz  | 7  (350 ns)    | 15 (750 ns)    | 25 (1.25 us)    |
+| 16 MHz  | 6  (375 ns)    | 12 (750 ns)    | 20 (1.25 us)    |
+| 12 MHz  | 4  (333 ns)    | 9  (750 ns)    | 15 (1.25 us)    |
+| 9.6 MHz | 3  (312 ns)    | 7  (729 ns)    | 12 (1.25 us)    |
+| 8 MHz   | 3  (375 ns)    | 6  (750 ns)    | 10 (1.25 us)    |
+| 4.8 MHz | 2  (417 ns)    | 6  (1.25 us)   | 12 (2.5 us)     |
+
+The 4.8 MHz row is WS2811 slow mode (400 kHz),
+selected with true as the second template
+parameter. 800 kHz strips need 8 MHz or more.
+Lower clocks are too slow for either mode.
+
+Interrupts are off while a frame is written, so
+a frame must be shorter than 16 ms (about 500
+RGB pixels) for millis() to keep its count.
+
+Bytes are sent as they are stored, so the buffer
+or callback has to use the strip's color order,
+which is G, R, B for WS2812B and SK6812.
+
+  TinyWS2812<PB4> strip;
+  strip.begin();
+  strip.write(pixels, sizeof(pixels));
+*/
+
+#ifndef TinyWS2812_h
+#define TinyWS2812_h
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+// Fills pixel (bytesPerPixel long) with the color of LED number index
+typedef void (*TinyWS2812Generator)(uint16_t index, uint8_t *pixel);
+
+// One byte, MSB first. The pin is high from the first out, low after
+// t0h cycles for a 0 and after t1h cycles for a 1
+#define TINYWS2812_BYTE_LOOP \
+  "ldi  %[bits], 8             \n" /* 1                                  */ \
+  "2:                          \n"                                          \
+  "out  %[port], %[hi]         \n" /* 1  t = 0                           */ \
+  ".rept %[w1]                 \n"                                          \
+  "  nop                       \n"                                          \
+  ".endr                       \n"                                          \
+  "sbrs %[byte], 7             \n" /* 1/2                                */ \
+  "out  %[port], %[lo]         \n" /* 1  t = t0h for a 0                 */ \
+  "lsl  %[byte]                \n" /* 1                                  */ \
+  ".rept %[w2]                 \n"                                          \
+  "  nop                       \n"                                          \
+  ".endr                       \n"                                          \
+  "out  %[port], %[lo]         \n" /* 1  t = t1h                         */ \
+  ".rept %[w3]                 \n"                                          \
+  "  nop                       \n"                                          \
+  ".endr                       \n"                                          \
+  "dec  %[bits]                \n" /* 1                                  */ \
+  "brne 2b                     \n" /* 2  period = w1 + w2 + w3 + 8       */
+
+template <uint8_t pin, bool slow = false, uint8_t bytesPerPixel = 3, FastPinClaim claim = PIN_DEFAULT>
+struct TinyWS2812
+{
+  static_assert(F_CPU >= 4800000UL, "TinyWS2812: F_CPU must be 4.8 MHz or more");
+  static_assert(slow || F_CPU >= 8000000UL, "TinyWS2812: 800 kHz strips need 8 MHz or more, below that only WS2811 slow mode works");
+
+  // Target timing in clock cycles, rounded to nearest
+  static constexpr uint16_t t0h    = (F_CPU / 1000UL * (slow ? 500 : 350) + 500000UL) / 1000000UL;
+  static constexpr uint16_t t1h    = (F_CPU / 1000UL * (slow ? 1200 : 750) + 500000UL) / 1000000UL;
+  static constexpr uint16_t period = (F_CPU / 1000UL * (slow ? 2500 : 1250) + 500000UL) / 1000000UL;
+
+  // Padding for TINYWS2812_BYTE_LOOP. Too short targets give zero padding
+  static constexpr uint8_t w1 = (t0h > 2) ? t0h - 2 : 0;
+  static constexpr uint8_t w2 = (t1h > w1 + 4) ? t1h - w1 - 4 : 0;
+  static constexpr uint8_t w3 = (period > w1 + w2 + 8) ? period - w1 - w2 - 8 : 0;
+
+  typedef FastPin<pin, claim> DIN;
+
+  static void begin()
+  {
+    DIN::low();
+    DIN::output();
+  }
+
+  // Write length bytes from RAM
+  static void write(const uint8_t *buf, uint16_t length)
+  {
+    if(length == 0)
+      return;
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint8_t lo = PORTB & ~_BV(pin);
+    const uint8_t hi = lo | _BV(pin);
+    uint8_t byte, bits;
+    asm volatile(
+      "1:                          \n"
+      "ld   %[byte], %a[ptr]+      \n" // 2
+      TINYWS2812_BYTE_LOOP
+      "sbiw %[len], 1              \n" // 2
+      "brne 1b                     \n" // 2
+      : [ptr] "+e" (buf), [len] "+w" (length), [byte] "=&r" (byte), [bits] "=&d" (bits)
+      : [port] "I" (_SFR_IO_ADDR(PORTB)), [hi] "r" (hi), [lo] "r" (lo),
+        [w1] "n" (w1), [w2] "n" (w2), [w3] "n" (w3)
+    );
+    SREG = oldSREG;
+    latch();
+  }
+
+  // Write length bytes from PROGMEM
+  static void writeP(const uint8_t *buf, uint16_t length)
+  {
+    if(length == 0)
+      return;
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint8_t lo = PORTB & ~_BV(pin);
+    const uint8_t hi = lo | _BV(pin);
+    uint8_t byte, bits;
+    asm volatile(
+      "1:                          \n"
+      "lpm  %[byte], Z+            \n" // 3
+      TINYWS2812_BYTE_LOOP
+      "sbiw %[len], 1              \n" // 2
+      "brne 1b                     \n" // 2
+      : [ptr] "+z" (buf), [len] "+w" (length), [byte] "=&r" (byte), [bits] "=&d" (bits)
+      : [port] "I" (_SFR_IO_ADDR(PORTB)), [hi] "r" (hi), [lo] "r" (lo),
+        [w1] "n" (w1), [w2] "n" (w2), [w3] "n" (w3)
+    );
+    SREG = oldSREG;
+    latch();
+  }
+
+  // Write count pixels, each one computed by generator just before it's sent.
+  // The data line is low while the generator runs. WS2812B latches the frame
+  // after about 9 us of low time, so the generator has to finish within that
+  // (about 80 cycles at 9.6 MHz). SK6812 and WS2811 allow a lot longer
+  static void write(uint16_t count, TinyWS2812Generator generator)
+  {
+    uint8_t pixel[bytesPerPixel];
+    uint8_t oldSREG = SREG;
+    cli();
+    for(uint16_t i = 0; i < count; i++)
+    {
+      generator(i, pixel);
+      sendPixel(pixel);
+    }
+    SREG = oldSREG;
+    latch();
+  }
+
+  private:
+  static void sendPixel(const uint8_t *buf)
+  {
+    const uint8_t lo = PORTB & ~_BV(pin);
+    const uint8_t hi = lo | _BV(pin);
+    uint8_t byte, len, bits;
+    asm volatile(
+      "ldi  %[len], %[n]           \n"
+      "1:                          \n"
+      "ld   %[byte], %a[ptr]+      \n" // 2
+      TINYWS2812_BYTE_LOOP
+      "dec  %[len]                 \n" // 1
+      "brne 1b                     \n" // 2
+      : [ptr] "+e" (buf), [len] "=&d" (len), [byte] "=&r" (byte), [bits] "=&d" (bits)
+      : [port] "I" (_SFR_IO_ADDR(PORTB)), [hi] "r" (hi), [lo] "r" (lo), [n] "n" (bytesPerPixel),
+        [w1] "n" (w1), [w2] "n" (w2), [w3] "n" (w3)
+    );
+  }
+
+  // Low time that makes the LEDs show the new frame (280 us for WS2812B V5 and SK6812)
+  static void latch()
+  {
+    _delay_us(300);
+  }
+};
+
+#endif